@@ -0,0 +1,128 @@
+#ifndef AUTOPILOT_CPP
+#define AUTOPILOT_CPP
+
+#include "bots/autopilot.hpp"
+#include <algorithm>
+
+namespace Bots {
+
+AutopilotPolicy::AutopilotPolicy() {
+    this->distance_field = nullptr;
+    this->table = {0, 0};
+    this->tracked_game = nullptr;
+    this->tracked_tick = 0;
+    this->tracked_tail = {0, 0};
+    this->flood_mark = 0;
+}
+
+AutopilotPolicy::~AutopilotPolicy() {
+    delete this->distance_field;
+}
+
+void AutopilotPolicy::rebuild(const Snake::Game *game) {
+    Snake::GameTable playable_area = game->get_playable_area();
+    if (!this->distance_field || playable_area.width != table.width || playable_area.height != table.height) {
+        delete this->distance_field;
+        this->table = playable_area;
+        this->distance_field = new DistanceField(playable_area);
+        this->flood_marks.assign((size_t)playable_area.width * playable_area.height, 0);
+        this->flood_mark = 0;
+    }
+
+    this->distance_field->reset(game->get_apple_position());
+    for (Snake::Coordinates body_part : *game->get_snake_body()) {
+        this->distance_field->block(body_part);
+    }
+    this->distance_field->recompute();
+}
+
+void AutopilotPolicy::follow_snake(const Snake::Game *game) {
+    const Snake::SnakeBody *snake_body = game->get_snake_body();
+    Snake::Coordinates apple = game->get_apple_position();
+
+    bool next_tick = game == this->tracked_game && game->get_tick_count() == this->tracked_tick + 1;
+    if (!next_tick || !this->distance_field ||
+        !Snake::coordinates_are_equal(apple, this->distance_field->get_target())) {
+        // another game, skipped ticks or a new apple: start from scratch
+        this->rebuild(game);
+    } else {
+        // in a tick the head moves to a new cell and the old tail leaves its cell
+        this->distance_field->block(snake_body->get_head());
+        if (!game->is_cell_occupied(this->tracked_tail)) {
+            this->distance_field->unblock(this->tracked_tail);
+        }
+    }
+
+    this->tracked_game = game;
+    this->tracked_tick = game->get_tick_count();
+    this->tracked_tail = snake_body->get_tail();
+}
+
+uint32_t AutopilotPolicy::count_reachable_cells(const Snake::Game *game, Snake::Coordinates start, uint32_t limit) {
+    const Snake::Bitboard *bitboard = game->get_bitboard();
+    if (bitboard) {
+        return bitboard->count_reachable_cells(start, game->get_snake_body()->get_tail(), limit);
+    }
+
+    this->flood_mark++;
+    if (this->flood_mark == 0) {
+        std::fill(this->flood_marks.begin(), this->flood_marks.end(), 0);
+        this->flood_mark = 1;
+    }
+
+    this->flood_queue.clear();
+    this->flood_queue.push_back(this->distance_field->to_cell_index(start));
+    this->flood_marks[this->flood_queue.back()] = this->flood_mark;
+
+    for (size_t head = 0; head < this->flood_queue.size() && this->flood_queue.size() < limit; head++) {
+        uint32_t cell = this->flood_queue[head];
+        Snake::Coordinates position = {(uint16_t)(cell % table.width), (uint16_t)(cell / table.width)};
+        for (Snake::Direction direction : MOVE_DIRECTIONS) {
+            Snake::Coordinates neighbour = move_towards(position, direction);
+            uint32_t neighbour_cell = this->distance_field->to_cell_index(neighbour);
+            if (this->flood_marks[neighbour_cell] != this->flood_mark && is_safe_cell(game, neighbour)) {
+                this->flood_marks[neighbour_cell] = this->flood_mark;
+                this->flood_queue.push_back(neighbour_cell);
+            }
+        }
+    }
+    return std::min<uint32_t>(this->flood_queue.size(), limit);
+}
+
+Snake::Direction AutopilotPolicy::next_input(const Snake::Game *game) {
+    this->follow_snake(game);
+
+    Snake::Coordinates head = game->get_snake_body()->get_head();
+    uint32_t snake_length = game->get_snake_body()->size();
+
+    // prefer moves that leave room for the whole snake, then the shortest path, then the most room
+    Snake::Direction best_direction = Snake::DIRECTION_NONE;
+    bool best_roomy = false;
+    uint32_t best_distance = DistanceField::UNREACHABLE;
+    uint32_t best_room = 0;
+    for (Snake::Direction direction : MOVE_DIRECTIONS) {
+        Snake::Coordinates cell = move_towards(head, direction);
+        if (!can_turn(game, direction) || !is_safe_cell(game, cell)) {
+            continue;
+        }
+
+        uint32_t room = this->count_reachable_cells(game, cell, snake_length);
+        bool roomy = room >= snake_length;
+        uint32_t distance = this->distance_field->get_distance(cell);
+
+        bool better = best_direction == Snake::DIRECTION_NONE || (roomy && !best_roomy) ||
+                      (roomy == best_roomy && (distance < best_distance ||
+                                               (distance == best_distance && room > best_room)));
+        if (better) {
+            best_direction = direction;
+            best_roomy = roomy;
+            best_distance = distance;
+            best_room = room;
+        }
+    }
+    return best_direction;
+}
+
+} // namespace Bots
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef AUTOPILOT_HPP
+#define AUTOPILOT_HPP
+
+#include "bots/distance_field.hpp"
+#include "bots/policy.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Bots {
+
+// Follows the shortest path to the apple while avoiding moves that would
+// leave the head in an area too small for the snake.
+// The distances to the apple are kept up to date while the snake moves,
+// so a decision costs about as much as the cells whose distance changed
+class AutopilotPolicy : public Policy {
+  private:
+    DistanceField *distance_field;
+    Snake::GameTable table;
+
+    // what the distance field currently describes
+    const Snake::Game *tracked_game;
+    uint32_t tracked_tick;
+    Snake::Coordinates tracked_tail;
+
+    // flood fill scratch buffers
+    std::vector<uint32_t> flood_marks;
+    uint32_t flood_mark;
+    std::vector<uint32_t> flood_queue;
+
+    // Builds the distance field from scratch for the current state of the game
+    void rebuild(const Snake::Game *game);
+
+    // Brings the distance field in step with the game
+    void follow_snake(const Snake::Game *game);
+
+    // Counts the free cells reachable from start, stopping once limit cells are found
+    uint32_t count_reachable_cells(const Snake::Game *game, Snake::Coordinates start, uint32_t limit);
+
+  public:
+    AutopilotPolicy();
+    ~AutopilotPolicy();
+
+    AutopilotPolicy(const AutopilotPolicy &) = delete;
+    AutopilotPolicy &operator=(const AutopilotPolicy &) = delete;
+
+    Snake::Direction next_input(const Snake::Game *game) override;
+};
+} // namespace Bots
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef DISTANCE_FIELD_CPP
+#define DISTANCE_FIELD_CPP
+
+#include "bots/distance_field.hpp"
+#include <algorithm>
+
+namespace Bots {
+
+DistanceField::DistanceField(Snake::GameTable table) {
+    this->table = table;
+    size_t cell_count = (size_t)table.width * table.height;
+    this->distances.assign(cell_count, UNREACHABLE);
+    this->blocked.assign(cell_count, 0);
+    this->marks.assign(cell_count, 0);
+    this->current_mark = 0;
+    this->target = table.width + 1;
+}
+
+uint32_t DistanceField::next_mark() {
+    this->current_mark++;
+    if (this->current_mark == 0) {
+        // the marks wrapped around, old marks could be mistaken for new ones
+        std::fill(this->marks.begin(), this->marks.end(), 0);
+        this->current_mark = 1;
+    }
+    return this->current_mark;
+}
+
+uint32_t DistanceField::distance_through_neighbours(uint32_t cell) const {
+    uint32_t best = std::min(std::min(distances[cell - 1], distances[cell + 1]),
+                             std::min(distances[cell - table.width], distances[cell + table.width]));
+    return best == UNREACHABLE ? UNREACHABLE : best + 1;
+}
+
+void DistanceField::reset(Snake::Coordinates target) {
+    this->target = to_cell_index(target);
+    std::fill(this->blocked.begin(), this->blocked.end(), 0);
+    for (uint16_t x = 0; x < table.width; x++) {
+        this->blocked[x] = 1;
+        this->blocked[(size_t)(table.height - 1) * table.width + x] = 1;
+    }
+    for (uint16_t y = 0; y < table.height; y++) {
+        this->blocked[(size_t)y * table.width] = 1;
+        this->blocked[(size_t)y * table.width + table.width - 1] = 1;
+    }
+    std::fill(this->distances.begin(), this->distances.end(), UNREACHABLE);
+}
+
+void DistanceField::recompute() {
+    std::fill(this->distances.begin(), this->distances.end(), UNREACHABLE);
+    this->queue.clear();
+    if (!this->blocked[this->target]) {
+        this->distances[this->target] = 0;
+        this->queue.push_back(this->target);
+    }
+    this->propagate_decrease(this->queue);
+}
+
+void DistanceField::propagate_decrease(std::vector<uint32_t> &sources) {
+    // breadth first search, sources must be sorted by distance
+    const uint32_t offsets[4] = {1, (uint32_t)-1, table.width, (uint32_t)-table.width};
+    for (size_t head = 0; head < sources.size(); head++) {
+        uint32_t cell = sources[head];
+        uint32_t next_distance = this->distances[cell] + 1;
+        for (uint32_t offset : offsets) {
+            uint32_t neighbour = cell + offset;
+            if (!this->blocked[neighbour] && next_distance < this->distances[neighbour]) {
+                this->distances[neighbour] = next_distance;
+                sources.push_back(neighbour);
+            }
+        }
+    }
+}
+
+void DistanceField::unblock(Snake::Coordinates position) {
+    uint32_t cell = to_cell_index(position);
+    if (!this->blocked[cell]) {
+        return;
+    }
+    this->blocked[cell] = 0;
+    this->distances[cell] = cell == this->target ? 0 : this->distance_through_neighbours(cell);
+    if (this->distances[cell] == UNREACHABLE) {
+        return;
+    }
+
+    // the freed cell can only shorten the paths going through it
+    this->queue.clear();
+    this->queue.push_back(cell);
+    this->propagate_decrease(this->queue);
+}
+
+void DistanceField::block(Snake::Coordinates position) {
+    uint32_t cell = to_cell_index(position);
+    if (this->blocked[cell]) {
+        return;
+    }
+    this->blocked[cell] = 1;
+    if (this->distances[cell] == UNREACHABLE) {
+        return;
+    }
+
+    // Find every cell whose shortest paths all went through the blocked one:
+    // a cell is affected if none of its neighbours one step closer to the target is unaffected.
+    // Cells are visited by increasing distance, so their neighbours are always decided first
+    const uint32_t offsets[4] = {1, (uint32_t)-1, table.width, (uint32_t)-table.width};
+    uint32_t mark = this->next_mark();
+    this->affected.clear();
+    this->affected.push_back(cell);
+    this->marks[cell] = mark;
+
+    for (size_t head = 0; head < this->affected.size(); head++) {
+        uint32_t current = this->affected[head];
+        uint32_t child_distance = this->distances[current] + 1;
+        for (uint32_t offset : offsets) {
+            uint32_t child = current + offset;
+            if (this->blocked[child] || this->marks[child] == mark || this->distances[child] != child_distance) {
+                continue;
+            }
+
+            bool supported = false;
+            for (uint32_t parent_offset : offsets) {
+                uint32_t parent = child + parent_offset;
+                if (this->distances[parent] + 1 == child_distance && this->marks[parent] != mark &&
+                    !this->blocked[parent]) {
+                    supported = true;
+                    break;
+                }
+            }
+            if (!supported) {
+                this->marks[child] = mark;
+                this->affected.push_back(child);
+            }
+        }
+    }
+
+    for (uint32_t affected_cell : this->affected) {
+        this->distances[affected_cell] = UNREACHABLE;
+    }
+    this->distances[cell] = UNREACHABLE;
+
+    // Give the affected cells their new distance from their unaffected neighbours,
+    // then spread it to the other affected cells
+    this->queue.clear();
+    for (size_t i = 1; i < this->affected.size(); i++) {
+        uint32_t affected_cell = this->affected[i];
+        this->distances[affected_cell] = this->distance_through_neighbours(affected_cell);
+        if (this->distances[affected_cell] != UNREACHABLE) {
+            this->queue.push_back(affected_cell);
+        }
+    }
+    std::sort(this->queue.begin(), this->queue.end(),
+              [this](uint32_t a, uint32_t b) { return this->distances[a] < this->distances[b]; });
+    this->propagate_decrease(this->queue);
+}
+
+} // namespace Bots
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef DISTANCE_FIELD_HPP
+#define DISTANCE_FIELD_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Bots {
+
+// Shortest path distance from every cell of a table to a target cell,
+// going around the blocked cells. The border of the table is always blocked.
+// Blocking and unblocking a cell only updates the distances that change,
+// so following a moving snake costs far less than a new search every tick
+class DistanceField {
+  public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+  private:
+    Snake::GameTable table;
+    uint32_t target;
+    std::vector<uint32_t> distances;
+    std::vector<uint8_t> blocked;
+
+    // scratch buffers, reused to avoid allocations while playing
+    std::vector<uint32_t> marks;
+    uint32_t current_mark;
+    std::vector<uint32_t> queue;
+    std::vector<uint32_t> affected;
+
+    uint32_t next_mark();
+
+    // Returns the lowest distance among the neighbours of the cell plus one
+    uint32_t distance_through_neighbours(uint32_t cell) const;
+
+    // Lowers the distances around the given cells, which must already have their final distance
+    void propagate_decrease(std::vector<uint32_t> &sources);
+
+  public:
+    DistanceField(Snake::GameTable table);
+
+    // Moves the target and unblocks every cell except for the border.
+    // Every cell stays unreachable until recompute() is called, so the
+    // blocked cells can be set with block() first at no cost
+    void reset(Snake::Coordinates target);
+
+    // Computes every distance again from scratch, keeping the blocked cells
+    void recompute();
+
+    void block(Snake::Coordinates position);
+    void unblock(Snake::Coordinates position);
+
+    uint32_t to_cell_index(Snake::Coordinates position) const {
+        return (uint32_t)position.y * table.width + position.x;
+    }
+
+    bool is_blocked(Snake::Coordinates position) const {
+        return blocked[to_cell_index(position)];
+    }
+
+    uint32_t get_distance(Snake::Coordinates position) const {
+        return distances[to_cell_index(position)];
+    }
+
+    Snake::Coordinates get_target() const {
+        return {(uint16_t)(target % table.width), (uint16_t)(target / table.width)};
+    }
+};
+} // namespace Bots
+
+#endif
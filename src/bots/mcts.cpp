@@ -0,0 +1,396 @@
+#ifndef MCTS_CPP
+#define MCTS_CPP
+
+#include "bots/mcts.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace Bots {
+
+MctsPolicy::MctsPolicy(uint64_t seed, MctsConfig config) {
+    this->config = config;
+    this->seed = seed;
+    this->root = NO_NODE;
+    this->root_state = new Snake::GameState();
+    this->expected_state = new Snake::GameState();
+    this->has_expected_state = false;
+    this->total_playouts = 0;
+    this->total_seconds = 0;
+    this->last_playouts = 0;
+    this->nodes.reserve(config.max_nodes);
+    this->spare_nodes.reserve(config.max_nodes);
+
+    this->thread_count = config.thread_count ? config.thread_count : std::thread::hardware_concurrency();
+    if (!this->thread_count) {
+        this->thread_count = 1;
+    }
+    this->decision_count = 0;
+    this->decision_seed = 0;
+    this->decision_playouts = nullptr;
+    this->running_helpers = 0;
+    this->stopping = false;
+}
+
+MctsPolicy::~MctsPolicy() {
+    {
+        std::lock_guard<std::mutex> lock(this->decision_mutex);
+        this->stopping = true;
+    }
+    this->decision_started.notify_all();
+    for (std::thread &helper : this->helpers) {
+        helper.join();
+    }
+
+    for (Snake::Game *game : this->worker_games) {
+        delete game;
+    }
+    delete this->root_state;
+    delete this->expected_state;
+}
+
+uint32_t MctsPolicy::new_node(uint32_t parent, Snake::Direction direction) {
+    if (this->nodes.size() >= this->config.max_nodes) {
+        return NO_NODE;
+    }
+
+    Node node;
+    node.parent = parent;
+    for (uint32_t &child : node.children) {
+        child = NO_NODE;
+    }
+    node.direction = direction;
+    node.expanded = false;
+    node.terminal = false;
+    node.visits = 0;
+    node.virtual_losses = 0;
+    node.total_reward = 0;
+    this->nodes.push_back(node);
+    return this->nodes.size() - 1;
+}
+
+uint32_t MctsPolicy::select_child(const Node &node) const {
+    double log_visits = std::log((double)node.visits + node.virtual_losses + 1);
+
+    uint32_t best_child = NO_NODE;
+    double best_score = -1;
+    for (uint32_t child_index : node.children) {
+        if (child_index == NO_NODE) {
+            continue;
+        }
+        const Node &child = this->nodes[child_index];
+        uint32_t visits = child.visits + child.virtual_losses;
+        if (!visits) {
+            // unvisited children go first, the virtual loss spreads them between threads
+            return child_index;
+        }
+
+        double score =
+            child.total_reward / visits + this->config.exploration * std::sqrt(log_visits / visits);
+        if (score > best_score) {
+            best_score = score;
+            best_child = child_index;
+        }
+    }
+    return best_child;
+}
+
+void MctsPolicy::keep_subtree(uint32_t subtree_root) {
+    // copy the subtree breadth first, the copy of a node always comes after the copy of its parent
+    this->spare_nodes.clear();
+    this->spare_nodes.push_back(this->nodes[subtree_root]);
+    this->spare_nodes[0].parent = NO_NODE;
+    for (size_t i = 0; i < this->spare_nodes.size(); i++) {
+        for (uint32_t &child : this->spare_nodes[i].children) {
+            if (child == NO_NODE) {
+                continue;
+            }
+            Node copy = this->nodes[child];
+            copy.parent = i;
+            child = this->spare_nodes.size();
+            this->spare_nodes.push_back(copy);
+        }
+    }
+
+    this->nodes.swap(this->spare_nodes);
+    this->root = 0;
+}
+
+void MctsPolicy::prepare_workers(const Snake::Game *game) {
+    Snake::GameTable playable_area = game->get_playable_area();
+    if (!this->worker_games.empty()) {
+        Snake::GameTable worker_area = this->worker_games[0]->get_playable_area();
+        if (worker_area.width != playable_area.width || worker_area.height != playable_area.height ||
+            this->worker_games[0]->get_level() != game->get_level()) {
+            for (Snake::Game *worker_game : this->worker_games) {
+                delete worker_game;
+            }
+            this->worker_games.clear();
+        }
+    }
+
+    Snake::GameTable game_table = game->get_game_table();
+    while (this->worker_games.size() < this->thread_count) {
+        this->worker_games.push_back(new Snake::Game(game_table.height, game_table.width, game->get_game_difficulty(),
+                                                     game->get_level(), 0));
+    }
+
+    // no decision runs yet, the new helpers wait for the next one
+    while (this->helpers.size() + 1 < this->thread_count) {
+        this->helpers.emplace_back(&MctsPolicy::run_helper, this, this->helpers.size() + 1, this->decision_count);
+    }
+}
+
+void MctsPolicy::run_helper(uint32_t worker_index, uint64_t decisions_seen) {
+    while (true) {
+        uint64_t worker_seed;
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<uint32_t> *playouts;
+        {
+            std::unique_lock<std::mutex> lock(this->decision_mutex);
+            this->decision_started.wait(lock,
+                                        [&]() { return this->stopping || this->decision_count != decisions_seen; });
+            if (this->stopping) {
+                return;
+            }
+            decisions_seen = this->decision_count;
+            worker_seed = this->decision_seed + worker_index;
+            deadline = this->decision_deadline;
+            playouts = this->decision_playouts;
+        }
+
+        this->run_worker(this->worker_games[worker_index], worker_seed, deadline, playouts);
+
+        {
+            std::lock_guard<std::mutex> lock(this->decision_mutex);
+            this->running_helpers--;
+        }
+        this->decision_finished.notify_one();
+    }
+}
+
+double MctsPolicy::rollout(Snake::Game *game, Snake::RandomGenerator &random_generator) {
+    // apples are worth less the later they are eaten, so the search goes for the closest ones
+    const double discount = 0.97;
+    double apple_value = 0;
+    uint32_t last_score = this->root_state->score;
+    Snake::Coordinates apple = game->get_apple_position();
+    for (uint32_t depth = 0; depth <= this->config.rollout_depth; depth++) {
+        if (game->get_score() != last_score) {
+            apple_value += std::pow(discount, game->get_tick_count() - this->root_state->tick_count);
+            last_score = game->get_score();
+        }
+        if (game->get_game_result() != Snake::GAME_UNFINISHED || depth == this->config.rollout_depth) {
+            break;
+        }
+
+        Snake::Coordinates head = game->get_snake_body()->get_head();
+        Snake::Direction safe_directions[MOVE_DIRECTION_COUNT];
+        uint32_t safe_count = 0;
+        Snake::Direction closer_direction = Snake::DIRECTION_NONE;
+        uint32_t closer_distance = UINT32_MAX;
+        for (Snake::Direction direction : MOVE_DIRECTIONS) {
+            Snake::Coordinates cell = move_towards(head, direction);
+            if (!can_turn(game, direction) || !is_safe_cell(game, cell)) {
+                continue;
+            }
+            safe_directions[safe_count++] = direction;
+
+            uint32_t distance = std::abs(cell.x - apple.x) + std::abs(cell.y - apple.y);
+            if (distance < closer_distance) {
+                closer_distance = distance;
+                closer_direction = direction;
+            }
+        }
+
+        Snake::Direction direction = Snake::DIRECTION_NONE;
+        if (safe_count) {
+            // mostly heads to the apple, sometimes wanders off to explore other paths
+            direction = (random_generator.next() & 3) ? closer_direction
+                                                      : safe_directions[random_generator.next_bounded(safe_count)];
+        }
+        game->update_game(direction);
+        apple = game->get_apple_position();
+    }
+
+    switch (game->get_game_result()) {
+        case Snake::GAME_LOST:
+            return 0;
+        case Snake::GAME_WON:
+            return 1;
+        default:
+            break;
+    }
+
+    // surviving is worth half, apples and getting closer to the next one bring it towards a win
+    Snake::GameTable playable_area = game->get_playable_area();
+    Snake::Coordinates head = game->get_snake_body()->get_head();
+    double distance = std::abs(head.x - apple.x) + std::abs(head.y - apple.y);
+    double progress = apple_value + 0.1 * (1 - distance / (playable_area.width + playable_area.height));
+    return 0.5 + 0.5 * progress / (progress + 1);
+}
+
+void MctsPolicy::run_worker(Snake::Game *game, uint64_t worker_seed, std::chrono::steady_clock::time_point deadline,
+                            std::atomic<uint32_t> *playouts) {
+    Snake::RandomGenerator random_generator(worker_seed);
+    std::vector<uint32_t> path;
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (this->config.max_playouts && playouts->fetch_add(1) >= this->config.max_playouts) {
+            break;
+        }
+
+        // selection and expansion, the virtual loss marks the path as taken
+        path.clear();
+        {
+            std::lock_guard<std::mutex> lock(this->tree_mutex);
+            uint32_t node_index = this->root;
+            path.push_back(node_index);
+            while (!this->nodes[node_index].terminal) {
+                if (!this->nodes[node_index].expanded) {
+                    Snake::Direction direction = this->nodes[node_index].direction;
+                    bool expanded = true;
+                    for (uint32_t i = 0; i < MOVE_DIRECTION_COUNT; i++) {
+                        if (MOVE_DIRECTIONS[i] == ~direction) {
+                            continue;
+                        }
+                        uint32_t child = this->new_node(node_index, MOVE_DIRECTIONS[i]);
+                        expanded = expanded && child != NO_NODE;
+                        this->nodes[node_index].children[i] = child;
+                    }
+                    // a full pool leaves the node as a leaf
+                    this->nodes[node_index].expanded = expanded;
+                    if (!expanded) {
+                        break;
+                    }
+                }
+
+                node_index = this->select_child(this->nodes[node_index]);
+                path.push_back(node_index);
+                if (!this->nodes[node_index].visits) {
+                    break;
+                }
+            }
+            for (uint32_t index : path) {
+                this->nodes[index].virtual_losses++;
+            }
+        }
+
+        // replay the path on the copy of the game, then play out from the leaf
+        game->restore(this->root_state);
+        bool ended_in_tree = false;
+        for (size_t i = 1; i < path.size() && !ended_in_tree; i++) {
+            ended_in_tree = game->update_game(this->nodes[path[i]].direction) != Snake::GAME_UNFINISHED;
+        }
+        double reward = this->rollout(game, random_generator);
+
+        {
+            std::lock_guard<std::mutex> lock(this->tree_mutex);
+            if (ended_in_tree) {
+                this->nodes[path.back()].terminal = true;
+            }
+            for (uint32_t index : path) {
+                Node &node = this->nodes[index];
+                node.virtual_losses--;
+                node.visits++;
+                node.total_reward += reward;
+            }
+        }
+    }
+}
+
+// Compares the parts of two states that decide how the game goes on
+static bool same_position(const Snake::GameState *a, const Snake::GameState *b) {
+    return a->playable_width == b->playable_width && a->playable_height == b->playable_height &&
+           a->game_result == b->game_result && a->current_direction == b->current_direction &&
+           a->apple_cell == b->apple_cell && a->score == b->score && a->tick_count == b->tick_count &&
+           std::memcmp(a->random_state, b->random_state, sizeof(a->random_state)) == 0 &&
+           a->body_length == b->body_length &&
+           std::memcmp(a->body, b->body, a->body_length * sizeof(a->body[0])) == 0;
+}
+
+Snake::Direction MctsPolicy::next_input(const Snake::Game *game) {
+    if (!game->snapshot(this->root_state)) {
+        // the table does not fit in a GameState
+        return Snake::DIRECTION_NONE;
+    }
+
+    if (this->has_expected_state && this->root != NO_NODE && same_position(this->root_state, this->expected_state)) {
+        // the game went on as expected, the subtree of the last move is still valid
+        Node &root_node = this->nodes[this->root];
+        uint32_t chosen_child = NO_NODE;
+        for (uint32_t child : root_node.children) {
+            if (child != NO_NODE && this->nodes[child].direction == game->get_current_direction()) {
+                chosen_child = child;
+            }
+        }
+        if (chosen_child != NO_NODE) {
+            this->keep_subtree(chosen_child);
+        } else {
+            this->root = NO_NODE;
+        }
+    } else {
+        this->root = NO_NODE;
+    }
+    if (this->root == NO_NODE) {
+        this->nodes.clear();
+        this->root = this->new_node(NO_NODE, game->get_current_direction());
+    }
+
+    this->prepare_workers(game);
+
+    uint32_t frame_duration = Snake::get_frame_duration(game->get_game_difficulty(), game->get_level());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline =
+        this->config.budget_fraction > 0
+            ? start + std::chrono::microseconds((int64_t)(frame_duration * this->config.budget_fraction))
+            : std::chrono::steady_clock::time_point::max();
+
+    uint32_t playouts_before = this->nodes[this->root].visits;
+    std::atomic<uint32_t> playouts(0);
+    uint64_t decision_seed = this->seed ^ ((uint64_t)game->get_tick_count() * 0x9E3779B97F4A7C15ULL);
+
+    // wakes the helpers up, the calling thread works as well
+    {
+        std::lock_guard<std::mutex> lock(this->decision_mutex);
+        this->decision_seed = decision_seed;
+        this->decision_deadline = deadline;
+        this->decision_playouts = &playouts;
+        this->running_helpers = this->helpers.size();
+        this->decision_count++;
+    }
+    this->decision_started.notify_all();
+    this->run_worker(this->worker_games[0], decision_seed, deadline, &playouts);
+    {
+        std::unique_lock<std::mutex> lock(this->decision_mutex);
+        this->decision_finished.wait(lock, [this]() { return this->running_helpers == 0; });
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    this->last_playouts = this->nodes[this->root].visits - playouts_before;
+    this->total_playouts += this->last_playouts;
+    this->total_seconds += elapsed.count();
+
+    // the most visited move is the most reliable one
+    const Node &root_node = this->nodes[this->root];
+    uint32_t best_child = NO_NODE;
+    for (uint32_t child : root_node.children) {
+        if (child != NO_NODE && (best_child == NO_NODE || this->nodes[child].visits > this->nodes[best_child].visits)) {
+            best_child = child;
+        }
+    }
+    if (best_child == NO_NODE) {
+        this->has_expected_state = false;
+        return Snake::DIRECTION_NONE;
+    }
+
+    Snake::Game *simulation = this->worker_games[0];
+    simulation->restore(this->root_state);
+    simulation->update_game(this->nodes[best_child].direction);
+    this->has_expected_state = simulation->snapshot(this->expected_state);
+    return this->nodes[best_child].direction;
+}
+
+} // namespace Bots
+
+#endif
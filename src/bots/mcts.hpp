@@ -0,0 +1,135 @@
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include "bots/policy.hpp"
+#include "game/game_state.hpp"
+#include "game/random.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Bots {
+
+struct MctsConfig {
+    uint32_t thread_count;  // 0 means one thread per core
+    double budget_fraction; // share of the frame duration spent on every decision, 0 means only max_playouts
+    uint32_t max_playouts;  // ends a decision early after this many playouts, 0 means no limit
+    uint32_t rollout_depth; // ticks simulated by a rollout once it leaves the tree
+    uint32_t max_nodes;     // size of the node pool, the tree stops growing when it is full
+    double exploration;     // UCT exploration constant
+
+    MctsConfig() {
+        this->thread_count = 0;
+        this->budget_fraction = 0.5;
+        this->max_playouts = 0;
+        this->rollout_depth = 40;
+        this->max_nodes = 1 << 18;
+        this->exploration = 0.7;
+    }
+};
+
+// Monte Carlo tree search over copies of the game.
+// Every decision runs playouts on several threads for a share of the frame duration of the level,
+// a virtual loss keeps the threads on different branches of the tree.
+// The helper threads are started by the first decision and wait for the next one until the policy is destroyed.
+// The subtree of the chosen move is kept for the next tick
+class MctsPolicy : public Policy {
+  private:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    struct Node {
+        uint32_t parent;
+        uint32_t children[MOVE_DIRECTION_COUNT]; // NO_NODE until expanded, or if going backwards
+        Snake::Direction direction;              // direction of the snake once in this node
+        bool expanded;
+        bool terminal;
+        uint32_t visits;
+        uint32_t virtual_losses;
+        double total_reward;
+    };
+
+    MctsConfig config;
+    uint64_t seed;
+
+    // the tree is shared by every thread and only touched while holding tree_mutex
+    std::mutex tree_mutex;
+    std::vector<Node> nodes;
+    std::vector<Node> spare_nodes;
+    uint32_t root;
+
+    Snake::GameState *root_state;
+    // state after the last chosen move, the tree is kept if the next tick starts from it
+    Snake::GameState *expected_state;
+    bool has_expected_state;
+
+    // one copy of the game per thread
+    std::vector<Snake::Game *> worker_games;
+    uint32_t thread_count;
+
+    // the calling thread runs worker 0, helper i runs worker i
+    std::vector<std::thread> helpers;
+    // the current decision, only written by the calling thread while holding decision_mutex
+    std::mutex decision_mutex;
+    std::condition_variable decision_started;
+    std::condition_variable decision_finished;
+    uint64_t decision_count;
+    uint64_t decision_seed;
+    std::chrono::steady_clock::time_point decision_deadline;
+    std::atomic<uint32_t> *decision_playouts;
+    uint32_t running_helpers;
+    bool stopping;
+
+    uint64_t total_playouts;
+    double total_seconds;
+    uint32_t last_playouts;
+
+    uint32_t new_node(uint32_t parent, Snake::Direction direction);
+
+    // Picks the child with the best UCT score, counting virtual losses as visits without reward
+    uint32_t select_child(const Node &node) const;
+
+    // Keeps only the subtree of the given node, which becomes the root
+    void keep_subtree(uint32_t subtree_root);
+
+    // Creates the copies of the game if the table of the game changed, and starts the missing helpers
+    void prepare_workers(const Snake::Game *game);
+
+    // Runs the share of every decision of one helper thread, decisions_seen is the decision count at its start
+    void run_helper(uint32_t worker_index, uint64_t decisions_seen);
+
+    // Runs playouts from the root state until the deadline
+    void run_worker(Snake::Game *game, uint64_t worker_seed, std::chrono::steady_clock::time_point deadline,
+                    std::atomic<uint32_t> *playouts);
+
+    // Plays random safe moves, biased towards the apple, and scores the outcome between 0 and 1
+    double rollout(Snake::Game *game, Snake::RandomGenerator &random_generator);
+
+  public:
+    MctsPolicy(uint64_t seed, MctsConfig config = MctsConfig());
+    ~MctsPolicy();
+
+    MctsPolicy(const MctsPolicy &) = delete;
+    MctsPolicy &operator=(const MctsPolicy &) = delete;
+
+    Snake::Direction next_input(const Snake::Game *game) override;
+
+    uint64_t get_total_playouts() const {
+        return this->total_playouts;
+    }
+
+    uint32_t get_last_playouts() const {
+        return this->last_playouts;
+    }
+
+    // Average number of playouts per second of search, over every decision
+    double get_playouts_per_second() const {
+        return this->total_seconds > 0 ? this->total_playouts / this->total_seconds : 0;
+    }
+};
+} // namespace Bots
+
+#endif
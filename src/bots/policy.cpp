@@ -0,0 +1,75 @@
+#ifndef POLICY_CPP
+#define POLICY_CPP
+
+#include "bots/policy.hpp"
+#include "bots/autopilot.hpp"
+#include "bots/mcts.hpp"
+#include "bots/simple_policies.hpp"
+#include <cstring>
+
+namespace Bots {
+
+const Snake::Direction MOVE_DIRECTIONS[MOVE_DIRECTION_COUNT] = {Snake::DIRECTION_UP, Snake::DIRECTION_DOWN,
+                                                                Snake::DIRECTION_LEFT, Snake::DIRECTION_RIGHT};
+
+Policy *create_policy(const char *name, uint64_t seed) {
+    if (std::strcmp(name, "random") == 0) {
+        return new RandomPolicy(seed);
+    }
+    if (std::strcmp(name, "greedy") == 0) {
+        return new GreedyPolicy(seed);
+    }
+    if (std::strcmp(name, "autopilot") == 0) {
+        return new AutopilotPolicy();
+    }
+    if (std::strcmp(name, "mcts") == 0) {
+        return new MctsPolicy(seed);
+    }
+    return nullptr;
+}
+
+Snake::Coordinates move_towards(Snake::Coordinates position, Snake::Direction direction) {
+    switch (direction) {
+        case Snake::DIRECTION_UP:
+            position.y--;
+            break;
+        case Snake::DIRECTION_DOWN:
+            position.y++;
+            break;
+        case Snake::DIRECTION_LEFT:
+            position.x--;
+            break;
+        case Snake::DIRECTION_RIGHT:
+            position.x++;
+            break;
+        default:
+            break;
+    }
+    return position;
+}
+
+bool is_safe_cell(const Snake::Game *game, Snake::Coordinates cell) {
+    Snake::GameTable playable_area = game->get_playable_area();
+    if (cell.x == 0 || cell.y == 0 || cell.x >= playable_area.width - 1 || cell.y >= playable_area.height - 1) {
+        return false;
+    }
+    return !game->is_cell_occupied(cell) ||
+           Snake::coordinates_are_equal(cell, game->get_snake_body()->get_tail());
+}
+
+bool can_turn(const Snake::Game *game, Snake::Direction direction) {
+    return direction != ~game->get_current_direction();
+}
+
+Snake::GameResult play_game(Snake::Game *game, Policy *policy) {
+    uint32_t duration_ticks = Snake::get_game_duration_ticks(game->get_game_difficulty(), game->get_level());
+    while (game->get_game_result() == Snake::GAME_UNFINISHED && game->get_tick_count() < duration_ticks) {
+        game->update_game(policy->next_input(game));
+    }
+    game->win_game();
+    return game->get_game_result();
+}
+
+} // namespace Bots
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef POLICY_HPP
+#define POLICY_HPP
+
+#include "game/game.hpp"
+#include "game/logic.hpp"
+#include <cstdint>
+
+namespace Bots {
+
+#define MOVE_DIRECTION_COUNT 4
+
+// The four directions a snake can move to
+extern const Snake::Direction MOVE_DIRECTIONS[MOVE_DIRECTION_COUNT];
+
+// Decides the inputs of a game, one tick at a time.
+// A policy may keep state between ticks, so every game needs its own instance
+class Policy {
+  public:
+    virtual ~Policy() {
+    }
+
+    // Returns the input for the next tick of the game
+    virtual Snake::Direction next_input(const Snake::Game *game) = 0;
+};
+
+// Creates the policy with the given name ("random", "greedy", "autopilot", "mcts"),
+// returns nullptr if there is no policy with that name
+Policy *create_policy(const char *name, uint64_t seed);
+
+// Returns the position next to the given one in the given direction
+Snake::Coordinates move_towards(Snake::Coordinates position, Snake::Direction direction);
+
+// Returns true if the head can move to the given cell in the next tick without losing,
+// the current tail is safe because it moves away before the head moves
+bool is_safe_cell(const Snake::Game *game, Snake::Coordinates cell);
+
+// Returns true if the snake can move in that direction, i.e. it is not going backwards
+bool can_turn(const Snake::Game *game, Snake::Direction direction);
+
+// Plays a whole timed game headlessly, like SnakeGameManager::start_game does:
+// it ticks until the game ends or its duration runs out, then the game is won
+Snake::GameResult play_game(Snake::Game *game, Policy *policy);
+
+} // namespace Bots
+
+#endif
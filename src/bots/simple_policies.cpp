@@ -0,0 +1,54 @@
+#ifndef SIMPLE_POLICIES_CPP
+#define SIMPLE_POLICIES_CPP
+
+#include "bots/simple_policies.hpp"
+#include <cstdlib>
+
+namespace Bots {
+
+Snake::Direction RandomPolicy::next_input(const Snake::Game *game) {
+    Snake::Coordinates head = game->get_snake_body()->get_head();
+
+    Snake::Direction safe_directions[MOVE_DIRECTION_COUNT];
+    uint32_t safe_count = 0;
+    for (Snake::Direction direction : MOVE_DIRECTIONS) {
+        if (can_turn(game, direction) && is_safe_cell(game, move_towards(head, direction))) {
+            safe_directions[safe_count++] = direction;
+        }
+    }
+
+    if (!safe_count) {
+        return Snake::DIRECTION_NONE;
+    }
+    return safe_directions[this->random_generator.next_bounded(safe_count)];
+}
+
+Snake::Direction GreedyPolicy::next_input(const Snake::Game *game) {
+    Snake::Coordinates head = game->get_snake_body()->get_head();
+    Snake::Coordinates apple = game->get_apple_position();
+
+    Snake::Direction best_direction = Snake::DIRECTION_NONE;
+    uint32_t best_distance = UINT32_MAX;
+    uint32_t ties = 0;
+    for (Snake::Direction direction : MOVE_DIRECTIONS) {
+        Snake::Coordinates cell = move_towards(head, direction);
+        if (!can_turn(game, direction) || !is_safe_cell(game, cell)) {
+            continue;
+        }
+
+        uint32_t distance = std::abs(cell.x - apple.x) + std::abs(cell.y - apple.y);
+        if (distance < best_distance) {
+            best_direction = direction;
+            best_distance = distance;
+            ties = 1;
+        } else if (distance == best_distance && this->random_generator.next_bounded(++ties) == 0) {
+            // every tied direction has the same chance of being picked
+            best_direction = direction;
+        }
+    }
+    return best_direction;
+}
+
+} // namespace Bots
+
+#endif
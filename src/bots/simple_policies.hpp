@@ -0,0 +1,34 @@
+#ifndef SIMPLE_POLICIES_HPP
+#define SIMPLE_POLICIES_HPP
+
+#include "bots/policy.hpp"
+#include "game/random.hpp"
+
+namespace Bots {
+
+// Moves to a random safe cell
+class RandomPolicy : public Policy {
+  private:
+    Snake::RandomGenerator random_generator;
+
+  public:
+    RandomPolicy(uint64_t seed) : random_generator(seed) {
+    }
+
+    Snake::Direction next_input(const Snake::Game *game) override;
+};
+
+// Moves to the safe cell that is closest to the apple
+class GreedyPolicy : public Policy {
+  private:
+    Snake::RandomGenerator random_generator;
+
+  public:
+    GreedyPolicy(uint64_t seed) : random_generator(seed) {
+    }
+
+    Snake::Direction next_input(const Snake::Game *game) override;
+};
+} // namespace Bots
+
+#endif
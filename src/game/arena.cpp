@@ -0,0 +1,298 @@
+#ifndef ARENA_CPP
+#define ARENA_CPP
+
+#include "game/arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Snake {
+
+Arena::Arena(GameTable playable_area, uint32_t snake_count, uint32_t snake_length, uint32_t apple_count,
+             uint64_t seed)
+    : random_generator(seed) {
+
+    if (playable_area.width < 4 || playable_area.height < 4 || snake_length == 0) {
+        throw std::invalid_argument("The arena needs at least 2x2 cells inside of the borders and snakes of 1 part");
+    }
+    // every snake gets a slot on every other row, with a free cell after its head
+    uint32_t slots_per_row = (playable_area.width - 2 + 1) / (snake_length + 1);
+    uint32_t slot_rows = (playable_area.height - 2 + 1) / 2;
+    if ((uint64_t)slots_per_row * slot_rows < snake_count) {
+        throw std::invalid_argument("The snakes do not fit in the arena");
+    }
+
+    this->playable_area = playable_area;
+    this->snake_count = snake_count;
+    this->snake_length = snake_length;
+    this->alive_count = snake_count;
+    this->tick_count = 0;
+
+    size_t cell_count = (size_t)playable_area.width * playable_area.height;
+    this->owner.assign(cell_count, NO_SNAKE);
+    this->apple_index.assign(cell_count, NO_APPLE);
+    this->claim_tick.assign(cell_count, 0);
+    this->claim_snake.assign(cell_count, NO_SNAKE);
+
+    this->direction.assign(snake_count, DIRECTION_RIGHT);
+    this->alive.assign(snake_count, 1);
+    this->score.assign(snake_count, 0);
+    this->next_head_cell.assign(snake_count, 0);
+    this->dies.assign(snake_count, 0);
+    this->body_cells.assign((size_t)snake_count * snake_length, 0);
+    this->body_head_index.assign(snake_count, snake_length - 1);
+    this->body_length.assign(snake_count, 0);
+
+    for (uint32_t snake = 0; snake < snake_count; snake++) {
+        uint16_t y = 1 + 2 * (snake / slots_per_row);
+        uint16_t first_x = 1 + (snake % slots_per_row) * (snake_length + 1);
+        // from the tail to the head
+        for (uint32_t part = 0; part < snake_length; part++) {
+            this->push_snake_head(snake, this->to_cell_index({(uint16_t)(first_x + part), y}));
+        }
+    }
+
+    for (uint32_t apple = 0; apple < apple_count && this->new_apple_position(); apple++) {
+    }
+    this->assign_strips(1);
+}
+
+void Arena::assign_strips(uint32_t strip_count) {
+    this->strips.clear();
+    this->strips.resize(std::min<uint32_t>(strip_count, this->playable_area.height));
+    for (Strip &strip : this->strips) {
+        strip.moving.resize(this->strips.size());
+    }
+    for (uint32_t snake = 0; snake < this->snake_count; snake++) {
+        if (this->alive[snake]) {
+            this->strips[this->get_strip(this->get_head_cell(snake))].snakes.push_back(snake);
+        }
+    }
+}
+
+Coordinates Arena::get_snake_part(uint32_t snake, uint32_t index) const {
+    uint32_t head_index = this->body_head_index[snake];
+    uint32_t buffer_index = index <= head_index ? head_index - index : head_index + snake_length - index;
+    return this->to_coordinates(this->body_cells[(size_t)snake * snake_length + buffer_index]);
+}
+
+void Arena::push_snake_head(uint32_t snake, uint32_t cell) {
+    uint32_t head_index = this->body_head_index[snake] + 1;
+    if (head_index == this->snake_length) {
+        head_index = 0;
+    }
+    this->body_head_index[snake] = head_index;
+    this->body_cells[(size_t)snake * snake_length + head_index] = cell;
+    this->body_length[snake]++;
+    this->owner[cell] = snake;
+}
+
+void Arena::pop_snake_tail(uint32_t snake) {
+    uint32_t offset = this->body_length[snake] - 1;
+    uint32_t head_index = this->body_head_index[snake];
+    uint32_t tail_index = offset <= head_index ? head_index - offset : head_index + snake_length - offset;
+    this->owner[this->body_cells[(size_t)snake * snake_length + tail_index]] = NO_SNAKE;
+    this->body_length[snake]--;
+}
+
+void Arena::remove_snake(uint32_t snake) {
+    while (this->body_length[snake]) {
+        this->pop_snake_tail(snake);
+    }
+    this->alive[snake] = 0;
+}
+
+void Arena::add_apple(uint32_t cell) {
+    this->apple_index[cell] = this->apple_cells.size();
+    this->apple_cells.push_back(cell);
+}
+
+void Arena::remove_apple(uint32_t cell) {
+    // move the last apple into the hole left by the removed one
+    uint32_t index = this->apple_index[cell];
+    uint32_t last_cell = this->apple_cells.back();
+    this->apple_cells[index] = last_cell;
+    this->apple_index[last_cell] = index;
+    this->apple_cells.pop_back();
+    this->apple_index[cell] = NO_APPLE;
+}
+
+bool Arena::new_apple_position() {
+    const uint16_t inner_width = this->playable_area.width - 2;
+    const uint16_t inner_height = this->playable_area.height - 2;
+    // between ticks every alive snake covers snake_length cells
+    uint32_t free_cell_count =
+        (uint32_t)inner_width * inner_height - this->alive_count * this->snake_length - this->apple_cells.size();
+    if (!free_cell_count) {
+        return false;
+    }
+
+    // random cells are almost always free unless the snakes and the apples cover most of the board
+    for (uint32_t attempt = 0; attempt < 32; attempt++) {
+        uint32_t cell = this->to_cell_index({(uint16_t)(1 + this->random_generator.next_bounded(inner_width)),
+                                             (uint16_t)(1 + this->random_generator.next_bounded(inner_height))});
+        if (this->owner[cell] == NO_SNAKE && this->apple_index[cell] == NO_APPLE) {
+            this->add_apple(cell);
+            return true;
+        }
+    }
+
+    // otherwise pick the n-th free cell
+    uint32_t remaining = this->random_generator.next_bounded(free_cell_count);
+    for (uint16_t y = 1; y <= inner_height; y++) {
+        for (uint16_t x = 1; x <= inner_width; x++) {
+            uint32_t cell = this->to_cell_index({x, y});
+            if (this->owner[cell] == NO_SNAKE && this->apple_index[cell] == NO_APPLE && remaining-- == 0) {
+                this->add_apple(cell);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Phase> void Arena::run_phase(StripExecutor *executor, Phase phase) {
+    if (!executor) {
+        for (uint32_t strip_index = 0; strip_index < this->strips.size(); strip_index++) {
+            phase(strip_index);
+        }
+        return;
+    }
+    executor->run(this->strips.size(), phase);
+}
+
+void Arena::find_eaters(Strip &strip) {
+    strip.eaters.clear();
+    for (uint32_t snake : strip.snakes) {
+        if (this->apple_index[this->get_head_cell(snake)] != NO_APPLE) {
+            strip.eaters.push_back(snake);
+        }
+    }
+}
+
+void Arena::turn_and_move_tails(Strip &strip, const Direction *inputs) {
+    const uint32_t width = this->playable_area.width;
+    for (std::vector<uint32_t> &moving : strip.moving) {
+        moving.clear();
+    }
+
+    for (uint32_t snake : strip.snakes) {
+        // turn and find the next head cell, like Game::update_game does
+        const int8_t input = inputs[snake];
+        const int8_t current = this->direction[snake];
+        if ((input == DIRECTION_UP || input == DIRECTION_DOWN || input == DIRECTION_LEFT ||
+             input == DIRECTION_RIGHT) &&
+            input != current && input != (int8_t)~current) {
+            this->direction[snake] = input;
+        }
+
+        uint32_t head_cell = this->get_head_cell(snake);
+        uint32_t x = head_cell % width;
+        uint32_t y = head_cell / width;
+        switch (this->direction[snake]) {
+            case DIRECTION_UP:
+                y--;
+                break;
+            case DIRECTION_DOWN:
+                y++;
+                break;
+            case DIRECTION_LEFT:
+                x--;
+                break;
+            default:
+                x++;
+                break;
+        }
+        this->dies[snake] = x == 0 || y == 0 || x == width - 1 || y == this->playable_area.height - 1u;
+        this->next_head_cell[snake] = y * width + x;
+        if (!this->dies[snake]) {
+            // the strip of the next head checks its collisions
+            strip.moving[this->get_strip(this->next_head_cell[snake])].push_back(snake);
+        }
+
+        // every tail leaves its cell before any head moves
+        this->pop_snake_tail(snake);
+    }
+}
+
+void Arena::find_collisions(uint32_t strip_index) {
+    // every snake moving to a cell of this strip is checked here, so the claims on a cell never race
+    for (Strip &source : this->strips) {
+        for (uint32_t snake : source.moving[strip_index]) {
+            uint32_t cell = this->next_head_cell[snake];
+            if (this->claim_tick[cell] == this->tick_count) {
+                // heads moving to the same cell all die
+                this->dies[snake] = 1;
+                this->dies[this->claim_snake[cell]] = 1;
+            } else {
+                this->claim_tick[cell] = this->tick_count;
+                this->claim_snake[cell] = snake;
+            }
+
+            // heads moving onto a body die, even if that body dies in this tick too
+            if (this->owner[cell] != NO_SNAKE) {
+                this->dies[snake] = 1;
+            }
+        }
+    }
+}
+
+void Arena::move_heads(Strip &strip) {
+    strip.deaths = 0;
+    strip.leaving.clear();
+
+    size_t kept = 0;
+    for (uint32_t snake : strip.snakes) {
+        if (this->dies[snake]) {
+            this->remove_snake(snake);
+            strip.deaths++;
+            continue;
+        }
+
+        this->push_snake_head(snake, this->next_head_cell[snake]);
+        if (&this->strips[this->get_strip(this->next_head_cell[snake])] != &strip) {
+            strip.leaving.push_back(snake);
+            continue;
+        }
+        strip.snakes[kept++] = snake;
+    }
+    strip.snakes.resize(kept);
+}
+
+void Arena::step(const Direction *inputs, StripExecutor *executor) {
+    uint32_t strip_count = executor ? executor->get_strip_count() : 1;
+    if (strip_count != this->strips.size()) {
+        this->assign_strips(strip_count);
+    }
+    this->tick_count++;
+
+    // heads on an apple eat it, in snake order so the new apples only depend on the seed and the inputs
+    this->run_phase(executor, [this](uint32_t strip_index) { this->find_eaters(this->strips[strip_index]); });
+    std::vector<uint32_t> &eaters = this->strips[0].eaters;
+    for (size_t strip_index = 1; strip_index < this->strips.size(); strip_index++) {
+        eaters.insert(eaters.end(), this->strips[strip_index].eaters.begin(), this->strips[strip_index].eaters.end());
+    }
+    std::sort(eaters.begin(), eaters.end());
+    for (uint32_t snake : eaters) {
+        this->score[snake] += ARENA_APPLE_POINTS;
+        this->remove_apple(this->get_head_cell(snake));
+        this->new_apple_position();
+    }
+
+    this->run_phase(executor, [this, inputs](uint32_t strip_index) {
+        this->turn_and_move_tails(this->strips[strip_index], inputs);
+    });
+    this->run_phase(executor, [this](uint32_t strip_index) { this->find_collisions(strip_index); });
+    this->run_phase(executor, [this](uint32_t strip_index) { this->move_heads(this->strips[strip_index]); });
+
+    // snakes whose head crossed into another strip join it
+    for (Strip &strip : this->strips) {
+        this->alive_count -= strip.deaths;
+        for (uint32_t snake : strip.leaving) {
+            this->strips[this->get_strip(this->get_head_cell(snake))].snakes.push_back(snake);
+        }
+    }
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include "game/logic.hpp"
+#include "game/random.hpp"
+#include <cstdint>
+#include <functional>
+#include <stddef.h>
+#include <vector>
+
+namespace Snake {
+
+#define ARENA_APPLE_POINTS 10
+
+// Runs the strips of an Arena tick in parallel.
+// The tools implement it with their own threads, so the simulation does not depend on a thread pool
+class StripExecutor {
+  public:
+    virtual ~StripExecutor() {
+    }
+
+    // Number of strips to split the board in, usually one for every thread
+    virtual uint32_t get_strip_count() const = 0;
+
+    // Calls task(i) for every i below task_count, returns once all of them have finished
+    virtual void run(uint32_t task_count, const std::function<void(uint32_t)> &task) = 0;
+};
+
+// Many snakes and many apples on one shared board, advanced together by step().
+// Every cell records the snake covering it, so collisions are a lookup in that grid
+// and a tick costs about the same for each snake however many snakes there are.
+// Like in Game the snakes never grow. A snake dies if its head hits a border, a body
+// (its own or another one) or another head moving to the same cell, and its body then leaves the board.
+// The same seed and the same inputs always produce the same game.
+// A tick can be spread over threads: the board is split in horizontal strips and every strip moves
+// the snakes with their head inside of it, with the same result as a single threaded tick
+class Arena {
+  public:
+    static constexpr uint32_t NO_SNAKE = UINT32_MAX;
+
+  private:
+    static constexpr uint32_t NO_APPLE = UINT32_MAX;
+
+    GameTable playable_area;
+    uint32_t snake_count;
+    uint32_t snake_length;
+    uint32_t alive_count;
+    uint32_t tick_count;
+    RandomGenerator random_generator;
+
+    // per snake state, indexed by snake
+    std::vector<int8_t> direction;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> score;
+    std::vector<uint32_t> next_head_cell; // scratch buffer of step()
+    std::vector<uint8_t> dies;            // scratch buffer of step()
+
+    // snake bodies: a ring buffer of snake_length cell indices for every snake
+    std::vector<uint32_t> body_cells;
+    std::vector<uint32_t> body_head_index;
+    std::vector<uint32_t> body_length;
+
+    // per cell state, indexed by y * width + x
+    std::vector<uint32_t> owner;       // the snake covering the cell or NO_SNAKE
+    std::vector<uint32_t> apple_index; // position of the cell inside of apple_cells or NO_APPLE
+    std::vector<uint32_t> claim_tick;  // last tick a head moved to the cell, to find heads meeting
+    std::vector<uint32_t> claim_snake; // first snake whose head moved to the cell in claim_tick
+    std::vector<uint32_t> apple_cells;
+
+    struct Strip {
+        std::vector<uint32_t> snakes;              // alive snakes with their head inside of the strip
+        std::vector<uint32_t> eaters;              // snakes eating an apple in this tick
+        std::vector<std::vector<uint32_t>> moving; // snakes moving in this tick, by the strip of their next head
+        std::vector<uint32_t> leaving;             // snakes whose head moved to another strip in this tick
+        uint32_t deaths;
+    };
+    std::vector<Strip> strips;
+
+    uint32_t get_strip(uint32_t cell) const {
+        return (uint64_t)(cell / playable_area.width) * strips.size() / playable_area.height;
+    }
+
+    // Splits the board in strip_count strips of rows and puts every alive snake in the strip of its head
+    void assign_strips(uint32_t strip_count);
+
+    // The phases of step(), each one runs on a single strip and only writes cells and snakes of that strip,
+    // or cells that no other strip writes in the same phase
+    void find_eaters(Strip &strip);
+    void turn_and_move_tails(Strip &strip, const Direction *inputs);
+    void find_collisions(uint32_t strip_index);
+    void move_heads(Strip &strip);
+
+    // Runs phase on every strip, on the executor if there is one
+    template <typename Phase> void run_phase(StripExecutor *executor, Phase phase);
+
+    uint32_t to_cell_index(Coordinates position) const {
+        return (uint32_t)position.y * playable_area.width + position.x;
+    }
+
+    Coordinates to_coordinates(uint32_t cell) const {
+        return {(uint16_t)(cell % playable_area.width), (uint16_t)(cell / playable_area.width)};
+    }
+
+    uint32_t get_head_cell(uint32_t snake) const {
+        return body_cells[(size_t)snake * snake_length + body_head_index[snake]];
+    }
+
+    void push_snake_head(uint32_t snake, uint32_t cell);
+    void pop_snake_tail(uint32_t snake);
+    void remove_snake(uint32_t snake);
+
+    void add_apple(uint32_t cell);
+    void remove_apple(uint32_t cell);
+
+    // Places an apple on a random cell with no snake and no apple,
+    // returns false if there is no such cell
+    bool new_apple_position();
+
+  public:
+    // Lays out snake_count snakes of snake_length parts in rows, all of them going right,
+    // then places apple_count apples. Throws std::invalid_argument if they do not fit
+    Arena(GameTable playable_area, uint32_t snake_count, uint32_t snake_length, uint32_t apple_count, uint64_t seed);
+
+    // Advances every alive snake by one tick, inputs holds one input per snake.
+    // With an executor the board is split in its strip count and the strips are moved in parallel
+    void step(const Direction *inputs, StripExecutor *executor = nullptr);
+
+    GameTable get_playable_area() const {
+        return playable_area;
+    }
+
+    uint32_t get_snake_count() const {
+        return snake_count;
+    }
+
+    uint32_t get_alive_count() const {
+        return alive_count;
+    }
+
+    uint32_t get_tick_count() const {
+        return tick_count;
+    }
+
+    bool is_alive(uint32_t snake) const {
+        return alive[snake];
+    }
+
+    uint32_t get_score(uint32_t snake) const {
+        return score[snake];
+    }
+
+    Direction get_current_direction(uint32_t snake) const {
+        return (Direction)direction[snake];
+    }
+
+    Coordinates get_snake_head(uint32_t snake) const {
+        return to_coordinates(get_head_cell(snake));
+    }
+
+    // Returns the part of the snake at the given index, 0 is the head
+    Coordinates get_snake_part(uint32_t snake, uint32_t index) const;
+
+    uint32_t get_snake_length(uint32_t snake) const {
+        return body_length[snake];
+    }
+
+    // Returns the snake covering the cell or NO_SNAKE
+    uint32_t get_owner(Coordinates position) const {
+        return owner[to_cell_index(position)];
+    }
+
+    bool has_apple(Coordinates position) const {
+        return apple_index[to_cell_index(position)] != NO_APPLE;
+    }
+
+    uint32_t get_apple_count() const {
+        return apple_cells.size();
+    }
+
+    Coordinates get_apple_position(uint32_t index) const {
+        return to_coordinates(apple_cells[index]);
+    }
+};
+} // namespace Snake
+
+#endif
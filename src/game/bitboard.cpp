@@ -0,0 +1,126 @@
+#ifndef BITBOARD_CPP
+#define BITBOARD_CPP
+
+#include "game/bitboard.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Snake {
+
+Bitboard::Bitboard(GameTable table) {
+    this->width = table.width;
+    this->height = table.height;
+
+    // every cell from x = 1 to x = width - 2
+    for (uint32_t word = 0; word < BITBOARD_ROW_WORDS; word++) {
+        uint32_t first_x = word * 64;
+        uint32_t last_x = table.width - 2;
+        if (last_x >= first_x + 63) {
+            this->inner_mask[word] = UINT64_MAX;
+        } else if (last_x >= first_x) {
+            this->inner_mask[word] = UINT64_MAX >> (63 - (last_x - first_x));
+        } else {
+            this->inner_mask[word] = 0;
+        }
+    }
+    this->inner_mask[0] &= ~(uint64_t)1;
+
+    std::memset(this->body, 0, sizeof(this->body));
+}
+
+void Bitboard::clear_body() {
+    std::memset(this->body, 0, sizeof(this->body[0]) * this->height);
+}
+
+uint32_t Bitboard::count_reachable_cells(Coordinates start, Coordinates vacated, uint32_t limit) const {
+    // the first and the last rows are walls, the others are open between their walls where there is no body
+    uint64_t open[BITBOARD_MAX_ROWS][BITBOARD_ROW_WORDS];
+    uint64_t reached[BITBOARD_MAX_ROWS][BITBOARD_ROW_WORDS];
+    for (uint16_t y = 0; y < this->height; y++) {
+        bool inner_row = y > 0 && y < this->height - 1;
+        for (uint32_t word = 0; word < BITBOARD_ROW_WORDS; word++) {
+            open[y][word] = inner_row ? this->inner_mask[word] & ~this->body[y][word] : 0;
+            reached[y][word] = 0;
+        }
+    }
+    if (vacated.y > 0 && vacated.y < this->height - 1) {
+        open[vacated.y][vacated.x >> 6] |= this->inner_mask[vacated.x >> 6] & cell_bit(vacated);
+    }
+    if (!(open[start.y][start.x >> 6] & cell_bit(start)) || !limit) {
+        return 0;
+    }
+    reached[start.y][start.x >> 6] = cell_bit(start);
+
+    // rows that may still grow, the walls keep them away from the first and the last row
+    uint16_t top = start.y;
+    uint16_t bottom = start.y;
+    uint32_t count = 1;
+
+    // Grows a row from its neighbours above and below, then along the row as far as it is open.
+    // Returns true if the row changed
+    auto grow_row = [&](uint16_t y) {
+        uint64_t grown[BITBOARD_ROW_WORDS];
+        for (uint32_t word = 0; word < BITBOARD_ROW_WORDS; word++) {
+            grown[word] = (reached[y][word] | reached[y - 1][word] | reached[y + 1][word]) & open[y][word];
+        }
+        while (true) {
+            // shift every row left and right by one cell, carrying bits between the words
+            uint64_t next[BITBOARD_ROW_WORDS];
+            for (uint32_t word = 0; word < BITBOARD_ROW_WORDS; word++) {
+                uint64_t left = grown[word] << 1;
+                uint64_t right = grown[word] >> 1;
+                if (word > 0) {
+                    left |= grown[word - 1] >> 63;
+                }
+                if (word + 1 < BITBOARD_ROW_WORDS) {
+                    right |= grown[word + 1] << 63;
+                }
+                next[word] = (grown[word] | left | right) & open[y][word];
+            }
+            if (std::equal(next, next + BITBOARD_ROW_WORDS, grown)) {
+                break;
+            }
+            std::copy(next, next + BITBOARD_ROW_WORDS, grown);
+        }
+
+        if (std::equal(grown, grown + BITBOARD_ROW_WORDS, reached[y])) {
+            return false;
+        }
+        std::copy(grown, grown + BITBOARD_ROW_WORDS, reached[y]);
+        return true;
+    };
+
+    while (count < limit) {
+        // a sweep down and a sweep up spread the fill over whole columns at once
+        uint16_t first = std::max<uint16_t>(top - 1, 1);
+        uint16_t last = std::min<uint16_t>(bottom + 1, this->height - 2);
+        bool changed = false;
+        for (uint16_t y = first; y <= last; y++) {
+            changed = grow_row(y) || changed;
+        }
+        for (uint16_t y = last; y >= first; y--) {
+            changed = grow_row(y) || changed;
+        }
+        if (!changed) {
+            break;
+        }
+
+        count = 0;
+        for (uint16_t y = first; y <= last; y++) {
+            uint32_t row_count = 0;
+            for (uint32_t word = 0; word < BITBOARD_ROW_WORDS; word++) {
+                row_count += __builtin_popcountll(reached[y][word]);
+            }
+            if (row_count) {
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+            count += row_count;
+        }
+    }
+    return std::min(count, limit);
+}
+
+} // namespace Snake
+
+#endif
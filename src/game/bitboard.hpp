@@ -0,0 +1,57 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+
+namespace Snake {
+
+// Rows and 64 bit words per row of a Bitboard, enough for every table of get_playable_dimensions
+#define BITBOARD_MAX_ROWS 30
+#define BITBOARD_ROW_WORDS 2
+
+// The body stored as one bitmask per row, bit x of row y is the cell (x, y).
+// Collision checks are a single bit test and flood fills become a few word operations per row
+class Bitboard {
+  private:
+    uint16_t width;
+    uint16_t height;
+    uint64_t inner_mask[BITBOARD_ROW_WORDS]; // the cells of a row between the left and the right walls
+    uint64_t body[BITBOARD_MAX_ROWS][BITBOARD_ROW_WORDS];
+
+    static uint64_t cell_bit(Coordinates position) {
+        return (uint64_t)1 << (position.x & 63);
+    }
+
+  public:
+    // The table must fit, see fits()
+    Bitboard(GameTable table);
+
+    // Returns true if the table is small enough for a Bitboard
+    static bool fits(GameTable table) {
+        return table.height <= BITBOARD_MAX_ROWS && table.width <= BITBOARD_ROW_WORDS * 64;
+    }
+
+    bool is_body(Coordinates position) const {
+        return body[position.y][position.x >> 6] & cell_bit(position);
+    }
+
+    void set_body(Coordinates position) {
+        body[position.y][position.x >> 6] |= cell_bit(position);
+    }
+
+    void clear_body(Coordinates position) {
+        body[position.y][position.x >> 6] &= ~cell_bit(position);
+    }
+
+    // Removes the whole body
+    void clear_body();
+
+    // Counts the cells reachable from start through cells that are neither walls nor body,
+    // stopping once limit cells are found. The vacated cell counts as free even if the body covers it,
+    // e.g. the tail that moves away before the head moves
+    uint32_t count_reachable_cells(Coordinates start, Coordinates vacated, uint32_t limit) const;
+};
+} // namespace Snake
+
+#endif
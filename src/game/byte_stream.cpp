@@ -0,0 +1,135 @@
+#ifndef BYTE_STREAM_CPP
+#define BYTE_STREAM_CPP
+
+#include "game/byte_stream.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace Snake {
+
+void ByteWriter::write_u16(uint16_t value) {
+    write_u8(value & 0xFF);
+    write_u8(value >> 8);
+}
+
+void ByteWriter::write_u32(uint32_t value) {
+    write_u16(value & 0xFFFF);
+    write_u16(value >> 16);
+}
+
+void ByteWriter::write_u64(uint64_t value) {
+    write_u32(value & 0xFFFFFFFF);
+    write_u32(value >> 32);
+}
+
+void ByteWriter::write_bytes(const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    buffer->insert(buffer->end(), bytes, bytes + size);
+}
+
+void ByteWriter::write_varint(uint64_t value) {
+    while (value >= 0x80) {
+        write_u8((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    write_u8(value);
+}
+
+bool ByteReader::read_u8(uint8_t &value) {
+    if (remaining() < 1) {
+        return false;
+    }
+    value = data[offset++];
+    return true;
+}
+
+bool ByteReader::read_u16(uint16_t &value) {
+    if (remaining() < 2) {
+        return false;
+    }
+    value = data[offset] | (data[offset + 1] << 8);
+    offset += 2;
+    return true;
+}
+
+bool ByteReader::read_u32(uint32_t &value) {
+    if (remaining() < 4) {
+        return false;
+    }
+    uint16_t low = 0, high = 0;
+    read_u16(low);
+    read_u16(high);
+    value = low | ((uint32_t)high << 16);
+    return true;
+}
+
+bool ByteReader::read_u64(uint64_t &value) {
+    if (remaining() < 8) {
+        return false;
+    }
+    uint32_t low = 0, high = 0;
+    read_u32(low);
+    read_u32(high);
+    value = low | ((uint64_t)high << 32);
+    return true;
+}
+
+bool ByteReader::read_bytes(void *destination, size_t count) {
+    if (remaining() < count) {
+        return false;
+    }
+    std::memcpy(destination, data + offset, count);
+    offset += count;
+    return true;
+}
+
+bool ByteReader::read_varint(uint64_t &value) {
+    size_t start = offset;
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!read_u8(byte)) {
+            offset = start;
+            return false;
+        }
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    // too many bytes for a 64 bit value
+    offset = start;
+    return false;
+}
+
+bool read_file(const char *file_path, std::vector<uint8_t> &buffer) {
+    FILE *file = std::fopen(file_path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    buffer.clear();
+    uint8_t chunk[4096];
+    size_t read_bytes;
+    while ((read_bytes = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + read_bytes);
+    }
+
+    bool failed = std::ferror(file);
+    std::fclose(file);
+    return !failed;
+}
+
+bool write_file(const char *file_path, const std::vector<uint8_t> &buffer) {
+    FILE *file = std::fopen(file_path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool written = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    return std::fclose(file) == 0 && written;
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef BYTE_STREAM_HPP
+#define BYTE_STREAM_HPP
+
+#include <cstdint>
+#include <stddef.h>
+#include <vector>
+
+namespace Snake {
+
+// Appends little endian values to a byte buffer
+class ByteWriter {
+  private:
+    std::vector<uint8_t> *buffer;
+
+  public:
+    ByteWriter(std::vector<uint8_t> &buffer) : buffer(&buffer) {
+    }
+
+    void write_u8(uint8_t value) {
+        buffer->push_back(value);
+    }
+
+    void write_u16(uint16_t value);
+    void write_u32(uint32_t value);
+    void write_u64(uint64_t value);
+    void write_bytes(const void *data, size_t size);
+
+    // Writes 7 bits per byte, small values take a single byte
+    void write_varint(uint64_t value);
+
+    size_t size() const {
+        return buffer->size();
+    }
+};
+
+// Reads little endian values from a byte buffer.
+// Every read returns false, without moving forward, if there are not enough bytes left
+class ByteReader {
+  private:
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+
+  public:
+    ByteReader(const uint8_t *data, size_t size) : data(data), size(size), offset(0) {
+    }
+
+    bool read_u8(uint8_t &value);
+    bool read_u16(uint16_t &value);
+    bool read_u32(uint32_t &value);
+    bool read_u64(uint64_t &value);
+    bool read_bytes(void *destination, size_t count);
+    bool read_varint(uint64_t &value);
+
+    size_t get_offset() const {
+        return offset;
+    }
+
+    size_t remaining() const {
+        return size - offset;
+    }
+};
+
+// Reads a whole file into buffer, returns false if it could not be read
+bool read_file(const char *file_path, std::vector<uint8_t> &buffer);
+
+// Writes the whole buffer into a file, returns false if it could not be written
+bool write_file(const char *file_path, const std::vector<uint8_t> &buffer);
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef FREE_CELL_SET_CPP
+#define FREE_CELL_SET_CPP
+
+#include "game/free_cell_set.hpp"
+
+namespace Snake {
+
+FreeCellSet::FreeCellSet(GameTable table) {
+    this->width = table.width;
+    this->height = table.height;
+
+    uint32_t cell_count = (uint32_t)table.width * table.height;
+    this->cells = new uint32_t[cell_count];
+    this->positions = new uint32_t[cell_count];
+    this->count = 0;
+
+    for (uint32_t cell = 0; cell < cell_count; cell++) {
+        this->positions[cell] = NOT_FREE;
+    }
+
+    // the borders are never free
+    for (uint16_t y = 1; y + 1 < table.height; y++) {
+        for (uint16_t x = 1; x + 1 < table.width; x++) {
+            this->insert({x, y});
+        }
+    }
+}
+
+FreeCellSet::~FreeCellSet() {
+    delete[] this->cells;
+    delete[] this->positions;
+}
+
+void FreeCellSet::clear() {
+    for (uint32_t i = 0; i < this->count; i++) {
+        this->positions[this->cells[i]] = NOT_FREE;
+    }
+    this->count = 0;
+}
+
+void FreeCellSet::insert(Coordinates position) {
+    uint32_t cell = to_cell_index(position);
+    if (this->positions[cell] != NOT_FREE) {
+        return;
+    }
+    this->cells[this->count] = cell;
+    this->positions[cell] = this->count;
+    this->count++;
+}
+
+void FreeCellSet::remove(Coordinates position) {
+    uint32_t cell = to_cell_index(position);
+    uint32_t position_index = this->positions[cell];
+    if (position_index == NOT_FREE) {
+        return;
+    }
+
+    // move the last free cell into the hole left by the removed one
+    this->count--;
+    uint32_t last_cell = this->cells[this->count];
+    this->cells[position_index] = last_cell;
+    this->positions[last_cell] = position_index;
+    this->positions[cell] = NOT_FREE;
+}
+
+} // namespace Snake
+
+#endif
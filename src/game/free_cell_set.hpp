@@ -0,0 +1,79 @@
+#ifndef FREE_CELL_SET_HPP
+#define FREE_CELL_SET_HPP
+
+#include "game/logic.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stddef.h>
+
+namespace Snake {
+
+// Set of the cells inside of the borders that are not covered by the snake.
+// Stored as a dense array of cells plus the position of every cell inside of it,
+// so insertion, removal and picking the i-th free cell are all O(1)
+class FreeCellSet {
+  private:
+    static constexpr uint32_t NOT_FREE = UINT32_MAX;
+
+    uint32_t *cells;     // dense array of the free cells
+    uint32_t *positions; // index inside of cells for every cell of the table
+    uint32_t count;
+    uint16_t width;
+    uint16_t height;
+
+    uint32_t to_cell_index(Coordinates position) const {
+        return (uint32_t)position.y * width + position.x;
+    }
+
+  public:
+    // Every cell inside of the borders of the given table starts as free
+    FreeCellSet(GameTable table);
+    ~FreeCellSet();
+
+    FreeCellSet(const FreeCellSet &) = delete;
+    FreeCellSet &operator=(const FreeCellSet &) = delete;
+
+    bool contains(Coordinates position) const {
+        return positions[to_cell_index(position)] != NOT_FREE;
+    }
+
+    // Adds the cell to the set, does nothing if it is already free
+    void insert(Coordinates position);
+
+    // Removes the cell from the set, does nothing if it is not free
+    void remove(Coordinates position);
+
+    // Removes every cell, the order of the following insertions decides
+    // the order of get_element_at()
+    void clear();
+
+    // Returns the free cell at the given index, index must be lower than size()
+    Coordinates get_element_at(uint32_t index) const {
+        uint32_t cell = cells[index];
+        return {(uint16_t)(cell % width), (uint16_t)(cell / width)};
+    }
+
+    // Returns the index (y * width + x) of the free cell at the given index
+    uint32_t get_cell_index_at(uint32_t index) const {
+        return cells[index];
+    }
+
+    // Replaces the set with the given cell indices, in the same order,
+    // all of them must be distinct cells inside of the borders
+    template <typename CellIndex> void assign(const CellIndex *cell_indices, uint32_t cell_count) {
+        // a sequential fill is faster than clearing the old cells one by one
+        std::fill(positions, positions + (size_t)width * height, NOT_FREE);
+        for (uint32_t i = 0; i < cell_count; i++) {
+            cells[i] = cell_indices[i];
+            positions[cell_indices[i]] = i;
+        }
+        count = cell_count;
+    }
+
+    uint32_t size() const {
+        return count;
+    }
+};
+} // namespace Snake
+
+#endif
@@ -2,103 +2,392 @@
 #define GAME_CPP
 
 #include "game/game.hpp"
+#include "game/byte_stream.hpp"
 #include "game/logic.hpp"
 #include "game/snake_body.hpp"
 #include <stdexcept>
-#include <stdlib.h>
 
 namespace Snake {
 
-Game::Game(uint16_t table_height, uint16_t table_width, GameDifficulty game_difficulty, uint32_t level) {
-
-    this->game_difficulty = game_difficulty;
-    this->game_result = GAME_UNFINISHED;
+Game::Game(uint16_t table_height, uint16_t table_width, GameDifficulty game_difficulty, uint32_t level, uint64_t seed)
+    : random_generator(seed) {
 
     this->game_table.height = table_height;
     this->game_table.width = table_width;
+    this->playable_area = get_playable_dimensions(game_difficulty);
 
-    this->current_direction = DIRECTION_UP;
+    // parts go from the tail to the head
+    uint16_t initial_body_size = get_initial_body_size(game_difficulty);
+    Coordinates *initial_body = new Coordinates[initial_body_size];
+    get_initial_snake_body(this->playable_area, game_difficulty, initial_body);
 
-    this->playable_area = get_playable_dimensions(game_difficulty);
+    // the body can never hold more parts than the cells inside of the borders
+    size_t body_capacity = (size_t)(playable_area.width - 2) * (playable_area.height - 2);
+    this->setup(game_difficulty, level, seed, initial_body, initial_body_size, body_capacity, DIRECTION_UP, true);
+    delete[] initial_body;
+}
 
-    Coordinates snake_head_position;
-    snake_head_position.x = playable_area.width / 2;
-    snake_head_position.y = playable_area.height / 2;
+Game::Game(GameTable playable_area, GameDifficulty game_difficulty, uint32_t level, uint32_t initial_length,
+           uint64_t seed)
+    : random_generator(seed) {
 
-    this->snake_body = new SnakeBody(snake_head_position);
+    if (playable_area.width < 4 || playable_area.height < 4) {
+        throw std::invalid_argument("The playable area must have at least 2x2 cells inside of the borders");
+    }
+    uint64_t inner_cell_count = (uint64_t)(playable_area.width - 2) * (playable_area.height - 2);
+    if (initial_length < 2 || initial_length >= inner_cell_count) {
+        throw std::invalid_argument("The snake must have at least 2 parts and leave a free cell for the apple");
+    }
 
-    uint16_t remaining_snake_body_size = SNAKE_MINIMUM_BODY_SIZE + game_difficulty;
-    // Avoid asking yourself why it works
-    while (remaining_snake_body_size) {
-        Coordinates coords;
-        if (remaining_snake_body_size + snake_head_position.y >= this->playable_area.height - 2) {
-            coords.y = this->playable_area.height - 2;
-            coords.x = snake_head_position.x + remaining_snake_body_size - (coords.y - snake_head_position.y);
+    this->game_table = playable_area;
+    this->playable_area = playable_area;
 
-        } else {
-            coords.x = snake_head_position.x;
-            coords.y = snake_head_position.y + remaining_snake_body_size;
-        }
-        remaining_snake_body_size--;
-        this->snake_body->enqueue(coords);
+    // parts go from the tail to the head
+    Coordinates *initial_body = new Coordinates[initial_length];
+    get_serpentine_snake_body(playable_area, initial_length, initial_body);
+
+    // the head keeps going the way the last part was laid out
+    Coordinates neck = initial_body[initial_length - 2];
+    Coordinates head = initial_body[initial_length - 1];
+    Direction initial_direction = head.y < neck.y ? DIRECTION_UP : head.x > neck.x ? DIRECTION_RIGHT : DIRECTION_LEFT;
+
+    // the snake never grows, so the body only needs room for its initial parts
+    this->setup(game_difficulty, level, seed, initial_body, initial_length, initial_length, initial_direction, false);
+    delete[] initial_body;
+}
+
+void Game::setup(GameDifficulty game_difficulty, uint32_t level, uint64_t seed, const Coordinates *initial_body,
+                 uint32_t initial_length, size_t body_capacity, Direction initial_direction, bool track_free_cells) {
+    this->seed = seed;
+    this->game_difficulty = game_difficulty;
+    this->game_result = GAME_UNFINISHED;
+    this->current_direction = initial_direction;
+
+    this->snake_body = new SnakeBody(initial_body[0], body_capacity);
+    if (track_free_cells && Bitboard::fits(this->playable_area)) {
+        this->bitboard = new Bitboard(this->playable_area);
+        this->occupancy = nullptr;
+    } else {
+        this->bitboard = nullptr;
+        this->occupancy = new OccupancyGrid(this->playable_area);
+    }
+    this->set_body_cell(initial_body[0]);
+    if (track_free_cells) {
+        this->free_cells = new FreeCellSet(this->playable_area);
+        this->free_cells->remove(initial_body[0]);
+    } else {
+        this->free_cells = nullptr;
     }
+
+    for (uint32_t i = 1; i < initial_length; i++) {
+        this->push_snake_head(initial_body[i]);
+    }
+
     this->score = 0;
+    this->tick_count = 0;
     this->level = level;
     this->new_apple_position();
 }
 
-void Game::new_apple_position() {
-    bool valid_position = false;
-    while (!valid_position) {
-        // Generate random coordinates within the bounds of the playable area,
-        // but avoid the borders (first and last rows/columns)
-        this->apple_position.x = rand() % (this->playable_area.width - 2) + 1;  // Avoid left and right borders
-        this->apple_position.y = rand() % (this->playable_area.height - 2) + 1; // Avoid top and bottom borders
-
-        // Check if the apple position is valid, i.e., the apple
-        // does not overlap with the snake's body
-        valid_position = true;
-        for (uint16_t i = 0; i < this->snake_body->size(); ++i) {
-            auto body_part_element = this->snake_body->get_element_at(i);
-            if (body_part_element && coordinates_are_equal(this->apple_position, body_part_element->position)) {
-                valid_position = false;
-                break;
+Game::~Game() {
+    delete this->snake_body;
+    delete this->bitboard;
+    delete this->occupancy;
+    delete this->free_cells;
+}
+
+bool Game::new_apple_position() {
+    if (!this->free_cells) {
+        return this->sample_apple_position();
+    }
+
+    uint32_t free_cell_count = this->free_cells->size();
+    if (!free_cell_count) {
+        // the snake covers the whole table
+        return false;
+    }
+
+    // Every free cell is inside of the borders and not covered by the snake,
+    // so a single random pick is always a valid position
+    this->apple_position = this->free_cells->get_element_at(this->random_generator.next_bounded(free_cell_count));
+    return true;
+}
+
+bool Game::sample_apple_position() {
+    const uint16_t inner_width = this->playable_area.width - 2;
+    const uint16_t inner_height = this->playable_area.height - 2;
+    uint32_t free_cell_count = (uint32_t)inner_width * inner_height - this->snake_body->size();
+    if (!free_cell_count) {
+        // the snake covers the whole table
+        return false;
+    }
+
+    // random cells are almost always free unless the snake covers most of the table
+    for (uint32_t attempt = 0; attempt < 32; attempt++) {
+        Coordinates cell = {(uint16_t)(1 + this->random_generator.next_bounded(inner_width)),
+                            (uint16_t)(1 + this->random_generator.next_bounded(inner_height))};
+        if (!this->occupancy->is_occupied(cell)) {
+            this->apple_position = cell;
+            return true;
+        }
+    }
+
+    // otherwise pick the n-th free cell, skipping whole rows by counting their occupied cells
+    uint32_t remaining = this->random_generator.next_bounded(free_cell_count);
+    for (uint16_t y = 1; y <= inner_height; y++) {
+        uint32_t row_free_cells = inner_width - this->occupancy->count_occupied({1, y}, inner_width);
+        if (remaining >= row_free_cells) {
+            remaining -= row_free_cells;
+            continue;
+        }
+        for (uint16_t x = 1; x <= inner_width; x++) {
+            if (!this->occupancy->is_occupied({x, y}) && remaining-- == 0) {
+                this->apple_position = {x, y};
+                return true;
             }
         }
     }
+    return false;
+}
+
+void Game::clear_body_cells() {
+    if (this->bitboard) {
+        this->bitboard->clear_body();
+        return;
+    }
+    for (Coordinates body_part : *this->snake_body) {
+        this->occupancy->clear_occupied(body_part);
+    }
+}
+
+void Game::push_snake_head(Coordinates position) {
+    this->snake_body->enqueue(position);
+    this->set_body_cell(position);
+    if (this->free_cells) {
+        this->free_cells->remove(position);
+    }
+}
+
+Coordinates Game::pop_snake_tail() {
+    Coordinates tail = this->snake_body->dequeue();
+    this->clear_body_cell(tail);
+    if (this->free_cells) {
+        this->free_cells->insert(tail);
+    }
+    return tail;
 }
 
 uint32_t Game::calculate_points(uint32_t level, GameDifficulty difficulty) const {
-    uint32_t base_points = 10; // Points awarded for eating an apple
-    uint32_t difficulty_multiplier = 1;
+    return get_apple_points(level, difficulty);
+}
 
-    // Change multiplier based on difficulty
-    switch (difficulty) {
-        case DIFFICULTY_EASY:
-            difficulty_multiplier = 1;
-            break;
-        case DIFFICULTY_NORMAL:
-            difficulty_multiplier = 2;
-            break;
-        case DIFFICULTY_HARD:
-            difficulty_multiplier = 3;
-            break;
-        default:
-            throw std::invalid_argument("Invalid game difficulty");
+bool Game::snapshot(GameState *state) const {
+    const uint16_t width = this->playable_area.width;
+    if ((uint32_t)width * this->playable_area.height > GAME_STATE_MAX_CELLS || !this->free_cells) {
+        return false;
+    }
+
+    state->playable_width = width;
+    state->playable_height = this->playable_area.height;
+    state->game_result = this->game_result;
+    state->current_direction = this->current_direction;
+    state->apple_cell = this->apple_position.y * width + this->apple_position.x;
+    state->score = this->score;
+    state->tick_count = this->tick_count;
+    this->random_generator.get_state(state->random_state);
+
+    state->body_length = this->snake_body->size();
+    uint16_t *body_cell = state->body;
+    for (Coordinates body_part : *this->snake_body) {
+        *body_cell++ = body_part.y * width + body_part.x;
+    }
+
+    // the free cell set uses the same cell indices
+    state->free_cell_count = this->free_cells->size();
+    for (uint32_t i = 0; i < state->free_cell_count; i++) {
+        state->free_cells[i] = this->free_cells->get_cell_index_at(i);
+    }
+    return true;
+}
+
+bool Game::restore(const GameState *state) {
+    const uint16_t width = this->playable_area.width;
+    if (state->playable_width != width || state->playable_height != this->playable_area.height ||
+        !this->free_cells) {
+        return false;
+    }
+
+    this->game_result = (GameResult)state->game_result;
+    this->current_direction = (Direction)state->current_direction;
+    this->apple_position = {(uint16_t)(state->apple_cell % width), (uint16_t)(state->apple_cell / width)};
+    this->score = state->score;
+    this->tick_count = state->tick_count;
+    this->random_generator.set_state(state->random_state);
+
+    this->clear_body_cells();
+    // the body is rebuilt from the tail to the head
+    const uint16_t *body_cell = state->body + state->body_length - 1;
+    Coordinates tail = {(uint16_t)(*body_cell % width), (uint16_t)(*body_cell / width)};
+    this->snake_body->reset(tail);
+    this->set_body_cell(tail);
+    while (body_cell-- != state->body) {
+        Coordinates body_part = {(uint16_t)(*body_cell % width), (uint16_t)(*body_cell / width)};
+        this->snake_body->enqueue(body_part);
+        this->set_body_cell(body_part);
+    }
+
+    this->free_cells->assign(state->free_cells, state->free_cell_count);
+    return true;
+}
+
+void Game::save_state(std::vector<uint8_t> &buffer) const {
+    ByteWriter writer(buffer);
+    writer.write_u8(this->game_result);
+    writer.write_u8((uint8_t)this->current_direction);
+    writer.write_u16(this->apple_position.x);
+    writer.write_u16(this->apple_position.y);
+    writer.write_u32(this->score);
+    writer.write_u32(this->tick_count);
+
+    uint64_t random_state[4];
+    this->random_generator.get_state(random_state);
+    for (uint64_t word : random_state) {
+        writer.write_u64(word);
+    }
+
+    // cells are written as their index inside of the playable area
+    writer.write_varint(this->snake_body->size());
+    for (Coordinates body_part : *this->snake_body) {
+        writer.write_varint((uint32_t)body_part.y * playable_area.width + body_part.x);
+    }
+
+    // the order of the free cells decides where the next apples go,
+    // games without a free cell set sample the apples from the body cells alone
+    if (!this->free_cells) {
+        writer.write_varint(0);
+        return;
+    }
+    writer.write_varint(this->free_cells->size());
+    for (uint32_t i = 0; i < this->free_cells->size(); i++) {
+        Coordinates cell = this->free_cells->get_element_at(i);
+        writer.write_varint((uint32_t)cell.y * playable_area.width + cell.x);
+    }
+}
+
+static bool is_inner_cell(GameTable playable_area, Coordinates cell) {
+    return cell.x > 0 && cell.y > 0 && cell.x < playable_area.width - 1 && cell.y < playable_area.height - 1;
+}
+
+// Reads a cell index written by save_state, it must be inside of the borders and not read before.
+// seen marks the cells read so far
+static bool read_inner_cell(ByteReader &reader, GameTable playable_area, OccupancyGrid &seen, Coordinates &cell) {
+    uint64_t index;
+    if (!reader.read_varint(index) || index >= (uint64_t)playable_area.width * playable_area.height) {
+        return false;
+    }
+    cell.x = index % playable_area.width;
+    cell.y = index / playable_area.width;
+    if (!is_inner_cell(playable_area, cell) || seen.is_occupied(cell)) {
+        return false;
+    }
+    seen.set_occupied(cell);
+    return true;
+}
+
+bool Game::load_state(const uint8_t *data, size_t size) {
+    ByteReader reader(data, size);
+
+    uint8_t result, direction;
+    Coordinates apple;
+    uint32_t score, tick_count;
+    uint64_t random_state[4];
+    if (!reader.read_u8(result) || result > GAME_LOST || !reader.read_u8(direction) || !reader.read_u16(apple.x) ||
+        !reader.read_u16(apple.y) || !reader.read_u32(score) || !reader.read_u32(tick_count) ||
+        !is_inner_cell(this->playable_area, apple)) {
+        return false;
+    }
+    for (uint64_t &word : random_state) {
+        if (!reader.read_u64(word)) {
+            return false;
+        }
+    }
+
+    Direction current_direction = (Direction)(int8_t)direction;
+    if (current_direction != DIRECTION_UP && current_direction != DIRECTION_DOWN &&
+        current_direction != DIRECTION_LEFT && current_direction != DIRECTION_RIGHT) {
+        return false;
+    }
+
+    uint64_t body_size;
+    if (!reader.read_varint(body_size) || body_size == 0 || body_size > this->snake_body->get_capacity()) {
+        return false;
+    }
+    // a cell is either a body part or a free cell, and at most once
+    OccupancyGrid seen(this->playable_area);
+    std::vector<Coordinates> body(body_size);
+    for (Coordinates &body_part : body) {
+        if (!read_inner_cell(reader, this->playable_area, seen, body_part)) {
+            return false;
+        }
+    }
+
+    uint64_t free_cell_count;
+    if (!reader.read_varint(free_cell_count) || free_cell_count > this->snake_body->get_capacity()) {
+        return false;
+    }
+    // with a free cell set, every inner cell is listed exactly once. Without, there is no free cell list
+    uint64_t inner_cell_count = (uint64_t)(this->playable_area.width - 2) * (this->playable_area.height - 2);
+    if (this->free_cells ? body_size + free_cell_count != inner_cell_count : free_cell_count != 0) {
+        return false;
+    }
+    std::vector<Coordinates> free_cell_list(free_cell_count);
+    for (Coordinates &cell : free_cell_list) {
+        if (!read_inner_cell(reader, this->playable_area, seen, cell)) {
+            return false;
+        }
+    }
+
+    // the state is valid, it can replace the current one
+    this->game_result = (GameResult)result;
+    this->current_direction = current_direction;
+    this->apple_position = apple;
+    this->score = score;
+    this->tick_count = tick_count;
+    this->random_generator.set_state(random_state);
+
+    this->clear_body_cells();
+    this->snake_body->reset(body.back());
+    this->set_body_cell(body.back());
+    for (size_t i = body.size() - 1; i > 0; i--) {
+        this->snake_body->enqueue(body[i - 1]);
+        this->set_body_cell(body[i - 1]);
+    }
+
+    if (this->free_cells) {
+        this->free_cells->clear();
+        for (Coordinates cell : free_cell_list) {
+            this->free_cells->insert(cell);
+        }
     }
-    return base_points * difficulty_multiplier * level;
+    return true;
 }
 
 GameResult Game::update_game(Direction player_input) {
     if (this->game_result != GAME_UNFINISHED) {
         return this->game_result;
     }
-    SnakePart *snake_head = snake_body->get_head();
+    this->tick_count++;
 
-    if (coordinates_are_equal(snake_head->position, this->apple_position)) {
+    Coordinates snake_head = snake_body->get_head();
+
+    if (coordinates_are_equal(snake_head, this->apple_position)) {
         // Increase score and create a new apple
         this->score += this->calculate_points(this->level, this->game_difficulty);
-        this->new_apple_position();
+        if (!this->new_apple_position()) {
+            // there is no room left for another apple
+            this->win_game();
+            return this->game_result;
+        }
     }
 
     // if the desired direction is valid and is different from the current one
@@ -110,9 +399,9 @@ GameResult Game::update_game(Direction player_input) {
     }
 
     // move the tail
-    snake_body->dequeue();
+    this->pop_snake_tail();
 
-    Coordinates new_snake_head_pos = snake_head->position;
+    Coordinates new_snake_head_pos = snake_head;
 
     // move the head
     switch (this->current_direction) {
@@ -160,14 +449,14 @@ GameResult Game::update_game(Direction player_input) {
             break;
         }
     }
-    snake_body->enqueue(new_snake_head_pos);
-
     // if the head collides with the body, then the game is lost
-    for (size_t i = 1; i < this->snake_body->size(); i++) {
-        if (coordinates_are_equal(new_snake_head_pos, this->snake_body->get_element_at(i)->position)) {
-            game_result = GAME_LOST;
-            return GAME_LOST;
-        }
+    bool collided = this->is_body_cell(new_snake_head_pos);
+
+    this->push_snake_head(new_snake_head_pos);
+
+    if (collided) {
+        game_result = GAME_LOST;
+        return GAME_LOST;
     }
 
     return GAME_UNFINISHED;
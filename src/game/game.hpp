@@ -1,8 +1,15 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include "game/bitboard.hpp"
+#include "game/free_cell_set.hpp"
+#include "game/game_state.hpp"
 #include "game/logic.hpp"
+#include "game/occupancy_grid.hpp"
+#include "game/random.hpp"
 #include "game/snake_body.hpp"
+#include <cstdint>
+#include <vector>
 
 namespace Snake{
 
@@ -15,17 +22,89 @@ class Game {
     Direction current_direction;
     Coordinates apple_position;
     SnakeBody *snake_body;
+    Bitboard *bitboard;       // cells covered by snake_body, nullptr if the table does not fit in a Bitboard
+    OccupancyGrid *occupancy; // cells covered by snake_body when there is no bitboard
+    FreeCellSet *free_cells;  // cells inside of the borders not covered by snake_body, nullptr on large boards
     uint32_t level;
     uint32_t score;
+    uint32_t tick_count; // number of simulated calls to update_game
+    uint64_t seed;
+    RandomGenerator random_generator;
 
-    void new_apple_position();
+    // Places the apple on a random free cell,
+    // returns false if there is no free cell left
+    bool new_apple_position();
+
+    // new_apple_position for games without a free cell set: tries random cells,
+    // then falls back to picking a random free cell by counting the occupied cells row by row
+    bool sample_apple_position();
+
+    // Shared by the constructors, initial_body goes from the tail to the head
+    void setup(GameDifficulty game_difficulty, uint32_t level, uint64_t seed, const Coordinates *initial_body,
+               uint32_t initial_length, size_t body_capacity, Direction initial_direction, bool track_free_cells);
+
+    bool is_body_cell(Coordinates position) const {
+        return bitboard ? bitboard->is_body(position) : occupancy->is_occupied(position);
+    }
+
+    void set_body_cell(Coordinates position) {
+        if (bitboard) {
+            bitboard->set_body(position);
+        } else {
+            occupancy->set_occupied(position);
+        }
+    }
+
+    void clear_body_cell(Coordinates position) {
+        if (bitboard) {
+            bitboard->clear_body(position);
+        } else {
+            occupancy->clear_occupied(position);
+        }
+    }
+
+    // Removes the whole snake from the bitboard or the occupancy grid
+    void clear_body_cells();
+
+    // Moves the snake while keeping the body cells and free_cells in step with it
+    void push_snake_head(Coordinates position);
+    Coordinates pop_snake_tail();
 
   public:
-    Game(uint16_t table_height, uint16_t table_width, GameDifficulty game_difficulty, uint32_t level);
+    // seed drives every random choice of this game, e.g. the apple positions
+    Game(uint16_t table_height, uint16_t table_width, GameDifficulty game_difficulty, uint32_t level, uint64_t seed);
+
+    // Large board mode for simulations and benchmarks, e.g. 4096x4096 cells with a snake of a million parts.
+    // The playable area includes the borders and the snake starts laid out row by row from the bottom.
+    // Memory is the occupancy bitmap plus the body, and a tick costs the same whatever the length of the snake.
+    // Apples are sampled from the bitmap instead of a free cell set, so snapshot() and restore() are not available
+    Game(GameTable playable_area, GameDifficulty game_difficulty, uint32_t level, uint32_t initial_length,
+         uint64_t seed);
+    ~Game();
 
+    Game(const Game &) = delete;
+    Game &operator=(const Game &) = delete;
+
+    // Advances the simulation by exactly one tick.
+    // The same starting state and the same sequence of inputs always produce the same game
     GameResult update_game(Direction player_input);
 
     uint32_t calculate_points(uint32_t level, GameDifficulty difficulty) const;
+
+    // Copies the state of the game into a caller provided buffer without allocating.
+    // Returns false if the playable area is bigger than GAME_STATE_MAX_CELLS
+    bool snapshot(GameState *state) const;
+
+    // Restores a snapshot taken from a game with the same playable area, difficulty and level.
+    // Returns false, leaving the game unchanged, if the playable area does not match
+    bool restore(const GameState *state);
+
+    // Appends the whole state of the game to buffer
+    void save_state(std::vector<uint8_t> &buffer) const;
+
+    // Restores a state saved by a game with the same table, difficulty, level and seed.
+    // Returns false, leaving the game unchanged, if the data is not a valid state
+    bool load_state(const uint8_t *data, size_t size);
     
     void win_game();
 
@@ -41,6 +120,10 @@ class Game {
         return playable_area;
     }
 
+    Direction get_current_direction() const {
+        return current_direction;
+    }
+
     Coordinates get_apple_position() const {
         return apple_position;
     }
@@ -48,11 +131,34 @@ class Game {
     SnakeBody *get_snake_body() const {
         return snake_body;
     }
+
+    // Returns true if the given cell is covered by the snake
+    bool is_cell_occupied(Coordinates position) const {
+        return is_body_cell(position);
+    }
+
+    // Body as row bitmasks, nullptr if the table is too big for a Bitboard.
+    // Every table of get_playable_dimensions fits
+    const Bitboard *get_bitboard() const {
+        return bitboard;
+    }
     
     uint32_t get_score() const {
         return score;
     }
 
+    uint32_t get_level() const {
+        return level;
+    }
+
+    uint64_t get_seed() const {
+        return seed;
+    }
+
+    uint32_t get_tick_count() const {
+        return tick_count;
+    }
+
     GameResult get_game_result() const {
         return game_result;
     }
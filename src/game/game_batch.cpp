@@ -0,0 +1,230 @@
+#ifndef GAME_BATCH_CPP
+#define GAME_BATCH_CPP
+
+#include "game/game_batch.hpp"
+#include <stdexcept>
+
+namespace Snake {
+
+static const uint16_t NOT_FREE = UINT16_MAX;
+
+GameBatch::GameBatch(GameDifficulty game_difficulty, uint32_t level, const uint64_t *seeds, uint32_t game_count) {
+    this->game_difficulty = game_difficulty;
+    this->level = level;
+    this->playable_area = get_playable_dimensions(game_difficulty);
+    this->game_count = game_count;
+    this->apple_points = get_apple_points(level, game_difficulty);
+
+    this->cell_count = (uint32_t)playable_area.width * playable_area.height;
+    if (this->cell_count >= NOT_FREE) {
+        throw std::invalid_argument("The table is too big for a GameBatch");
+    }
+    this->words_per_game = (this->cell_count + 63) / 64;
+
+    uint16_t initial_body_size = get_initial_body_size(game_difficulty);
+    std::vector<Coordinates> initial_body(initial_body_size);
+    get_initial_snake_body(playable_area, game_difficulty, initial_body.data());
+    this->body_capacity = initial_body_size;
+
+    this->head_x.assign(game_count, 0);
+    this->head_y.assign(game_count, 0);
+    this->direction.assign(game_count, DIRECTION_UP);
+    this->apple_x.assign(game_count, 0);
+    this->apple_y.assign(game_count, 0);
+    this->score.assign(game_count, 0);
+    this->tick_count.assign(game_count, 0);
+    this->game_result.assign(game_count, GAME_UNFINISHED);
+    this->body_cells.assign((size_t)game_count * body_capacity, 0);
+    this->body_head_index.assign(game_count, body_capacity - 1);
+    this->body_length.assign(game_count, 0);
+    this->occupancy.assign((size_t)game_count * words_per_game, 0);
+    this->free_cells.assign((size_t)game_count * cell_count, 0);
+    this->free_cell_positions.assign((size_t)game_count * cell_count, NOT_FREE);
+    this->free_cell_count.assign(game_count, 0);
+    this->next_head_x.assign(game_count, 0);
+    this->next_head_y.assign(game_count, 0);
+    this->hits_border.assign(game_count, 0);
+    this->eats.assign(game_count, 0);
+    this->eaters.assign(game_count, 0);
+    this->random_generators.reserve(game_count);
+
+    for (uint32_t game = 0; game < game_count; game++) {
+        this->random_generators.push_back(RandomGenerator(seeds[game]));
+
+        // same insertion order as FreeCellSet, so apples land on the same cells
+        for (uint16_t y = 1; y + 1 < playable_area.height; y++) {
+            for (uint16_t x = 1; x + 1 < playable_area.width; x++) {
+                this->insert_free_cell(game, y * playable_area.width + x);
+            }
+        }
+
+        for (Coordinates part : initial_body) {
+            this->push_snake_head(game, part.y * playable_area.width + part.x);
+        }
+        this->head_x[game] = initial_body.back().x;
+        this->head_y[game] = initial_body.back().y;
+        this->new_apple_position(game);
+    }
+}
+
+void GameBatch::insert_free_cell(uint32_t game, uint16_t cell) {
+    uint16_t *positions = &this->free_cell_positions[(size_t)game * cell_count];
+    if (positions[cell] != NOT_FREE) {
+        return;
+    }
+    uint16_t *cells = &this->free_cells[(size_t)game * cell_count];
+    cells[free_cell_count[game]] = cell;
+    positions[cell] = free_cell_count[game];
+    free_cell_count[game]++;
+}
+
+void GameBatch::remove_free_cell(uint32_t game, uint16_t cell) {
+    uint16_t *positions = &this->free_cell_positions[(size_t)game * cell_count];
+    uint16_t position_index = positions[cell];
+    if (position_index == NOT_FREE) {
+        return;
+    }
+    uint16_t *cells = &this->free_cells[(size_t)game * cell_count];
+    free_cell_count[game]--;
+    uint16_t last_cell = cells[free_cell_count[game]];
+    cells[position_index] = last_cell;
+    positions[last_cell] = position_index;
+    positions[cell] = NOT_FREE;
+}
+
+void GameBatch::push_snake_head(uint32_t game, uint16_t cell) {
+    uint32_t head_index = body_head_index[game] + 1;
+    if (head_index == body_capacity) {
+        head_index = 0;
+    }
+    body_head_index[game] = head_index;
+    body_cells[(size_t)game * body_capacity + head_index] = cell;
+    body_length[game]++;
+
+    occupancy[game * words_per_game + (cell >> 6)] |= (uint64_t)1 << (cell & 63);
+    this->remove_free_cell(game, cell);
+}
+
+uint16_t GameBatch::pop_snake_tail(uint32_t game) {
+    uint32_t offset = body_length[game] - 1;
+    uint32_t head_index = body_head_index[game];
+    uint32_t tail_index = offset <= head_index ? head_index - offset : head_index + body_capacity - offset;
+    uint16_t cell = body_cells[(size_t)game * body_capacity + tail_index];
+    body_length[game]--;
+
+    occupancy[game * words_per_game + (cell >> 6)] &= ~((uint64_t)1 << (cell & 63));
+    this->insert_free_cell(game, cell);
+    return cell;
+}
+
+bool GameBatch::new_apple_position(uint32_t game) {
+    if (!free_cell_count[game]) {
+        return false;
+    }
+    uint32_t index = random_generators[game].next_bounded(free_cell_count[game]);
+    uint16_t cell = free_cells[(size_t)game * cell_count + index];
+    apple_x[game] = cell % playable_area.width;
+    apple_y[game] = cell / playable_area.width;
+    return true;
+}
+
+void GameBatch::win_game(uint32_t game) {
+    if (game_result[game] == GAME_UNFINISHED) {
+        score[game] += apple_points * level;
+        game_result[game] = GAME_WON;
+    }
+}
+
+void GameBatch::step(const Direction *inputs) {
+    const uint32_t count = this->game_count;
+
+    // count the ticks and find the games that eat, branch free so the compiler can vectorize it
+    const uint8_t *const results = this->game_result.data();
+    const uint16_t *const current_x = this->head_x.data();
+    const uint16_t *const current_y = this->head_y.data();
+    const uint16_t *const apples_x = this->apple_x.data();
+    const uint16_t *const apples_y = this->apple_y.data();
+    uint32_t *const ticks = this->tick_count.data();
+    uint8_t *const eats = this->eats.data();
+    for (uint32_t game = 0; game < count; game++) {
+        const uint8_t unfinished = results[game] == GAME_UNFINISHED;
+        ticks[game] += unfinished;
+        eats[game] = unfinished & (current_x[game] == apples_x[game]) & (current_y[game] == apples_y[game]);
+    }
+
+    // only a few games eat in the same tick, collect them and eat in game order
+    uint32_t eater_count = 0;
+    uint32_t *const eaters = this->eaters.data();
+    for (uint32_t game = 0; game < count; game++) {
+        eaters[eater_count] = game;
+        eater_count += eats[game];
+    }
+    for (uint32_t i = 0; i < eater_count; i++) {
+        const uint32_t game = eaters[i];
+        score[game] += apple_points;
+        if (!this->new_apple_position(game)) {
+            this->win_game(game);
+        }
+    }
+
+    // The next loops are branch free over plain arrays, so the compiler can vectorize them
+    int8_t *const directions = this->direction.data();
+    for (uint32_t game = 0; game < count; game++) {
+        const int8_t input = inputs[game];
+        const int8_t current = directions[game];
+        const bool is_direction = input == DIRECTION_UP || input == DIRECTION_DOWN || input == DIRECTION_LEFT ||
+                                  input == DIRECTION_RIGHT;
+        const bool turns = is_direction && input != current && input != (int8_t)~current &&
+                           results[game] == GAME_UNFINISHED;
+        directions[game] = turns ? input : current;
+    }
+
+    const uint16_t last_column = playable_area.width - 1;
+    const uint16_t last_row = playable_area.height - 1;
+    uint16_t *const new_x = this->next_head_x.data();
+    uint16_t *const new_y = this->next_head_y.data();
+    uint8_t *const border = this->hits_border.data();
+    for (uint32_t game = 0; game < count; game++) {
+        const int8_t current = directions[game];
+        const uint16_t x = current_x[game] + (current == DIRECTION_RIGHT) - (current == DIRECTION_LEFT);
+        const uint16_t y = current_y[game] + (current == DIRECTION_DOWN) - (current == DIRECTION_UP);
+        new_x[game] = x;
+        new_y[game] = y;
+        border[game] = (x == 0) | (y == 0) | (x == last_column) | (y == last_row);
+    }
+
+    // move the snakes, in the same order as Game::update_game
+    for (uint32_t game = 0; game < count; game++) {
+        if (game_result[game] != GAME_UNFINISHED) {
+            continue;
+        }
+        this->pop_snake_tail(game);
+
+        if (border[game]) {
+            game_result[game] = GAME_LOST;
+            continue;
+        }
+
+        uint16_t cell = new_y[game] * playable_area.width + new_x[game];
+        bool collided = this->is_occupied(game, cell);
+        this->push_snake_head(game, cell);
+        head_x[game] = new_x[game];
+        head_y[game] = new_y[game];
+
+        if (collided) {
+            game_result[game] = GAME_LOST;
+        }
+    }
+}
+
+uint32_t GameBatch::get_unfinished_count() const {
+    uint32_t unfinished = 0;
+    for (uint32_t game = 0; game < game_count; game++) {
+        unfinished += game_result[game] == GAME_UNFINISHED;
+    }
+    return unfinished;
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef GAME_BATCH_HPP
+#define GAME_BATCH_HPP
+
+#include "game/logic.hpp"
+#include "game/random.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Snake {
+
+// Many games of the same difficulty and level stored as structure of arrays
+// and advanced together by a single step() call.
+// Every game behaves exactly like a Game built with the same seed
+// and given the same inputs.
+class GameBatch {
+  private:
+    GameDifficulty game_difficulty;
+    uint32_t level;
+    GameTable playable_area;
+    uint32_t game_count;
+    uint32_t apple_points;
+
+    // per game state, indexed by game
+    std::vector<uint16_t> head_x;
+    std::vector<uint16_t> head_y;
+    std::vector<int8_t> direction;
+    std::vector<uint16_t> apple_x;
+    std::vector<uint16_t> apple_y;
+    std::vector<uint32_t> score;
+    std::vector<uint32_t> tick_count;
+    std::vector<uint8_t> game_result;
+    std::vector<RandomGenerator> random_generators;
+
+    // snake bodies: a ring buffer of cell indices for every game.
+    // The snake never gets longer than it starts, so the ring buffers
+    // only need room for the initial body
+    uint32_t body_capacity;
+    std::vector<uint16_t> body_cells;
+    std::vector<uint32_t> body_head_index;
+    std::vector<uint32_t> body_length;
+
+    // occupancy bitsets, words_per_game words for every game
+    uint32_t words_per_game;
+    std::vector<uint64_t> occupancy;
+
+    // free cell sets, same layout as FreeCellSet, cell_count entries for every game
+    uint32_t cell_count;
+    std::vector<uint16_t> free_cells;
+    std::vector<uint16_t> free_cell_positions;
+    std::vector<uint32_t> free_cell_count;
+
+    // scratch buffers of step()
+    std::vector<uint16_t> next_head_x;
+    std::vector<uint16_t> next_head_y;
+    std::vector<uint8_t> hits_border;
+    std::vector<uint8_t> eats;
+    std::vector<uint32_t> eaters;
+
+    bool is_occupied(uint32_t game, uint32_t cell) const {
+        return (occupancy[game * words_per_game + (cell >> 6)] >> (cell & 63)) & 1;
+    }
+
+    void push_snake_head(uint32_t game, uint16_t cell);
+    uint16_t pop_snake_tail(uint32_t game);
+    void insert_free_cell(uint32_t game, uint16_t cell);
+    void remove_free_cell(uint32_t game, uint16_t cell);
+    bool new_apple_position(uint32_t game);
+
+  public:
+    // Creates game_count games, the i-th one seeded with seeds[i].
+    // Only the table sizes returned by get_playable_dimensions are supported
+    GameBatch(GameDifficulty game_difficulty, uint32_t level, const uint64_t *seeds, uint32_t game_count);
+
+    // Advances every unfinished game by one tick, inputs holds one input per game
+    void step(const Direction *inputs);
+
+    // Same as Game::win_game
+    void win_game(uint32_t game);
+
+    uint32_t get_game_count() const {
+        return game_count;
+    }
+
+    GameTable get_playable_area() const {
+        return playable_area;
+    }
+
+    GameResult get_game_result(uint32_t game) const {
+        return (GameResult)game_result[game];
+    }
+
+    uint32_t get_score(uint32_t game) const {
+        return score[game];
+    }
+
+    uint32_t get_tick_count(uint32_t game) const {
+        return tick_count[game];
+    }
+
+    Direction get_current_direction(uint32_t game) const {
+        return (Direction)direction[game];
+    }
+
+    Coordinates get_snake_head(uint32_t game) const {
+        return {head_x[game], head_y[game]};
+    }
+
+    Coordinates get_apple_position(uint32_t game) const {
+        return {apple_x[game], apple_y[game]};
+    }
+
+    uint32_t get_snake_length(uint32_t game) const {
+        return body_length[game];
+    }
+
+    bool is_cell_occupied(uint32_t game, Coordinates position) const {
+        return is_occupied(game, (uint32_t)position.y * playable_area.width + position.x);
+    }
+
+    // Returns the number of games that are still being played
+    uint32_t get_unfinished_count() const;
+};
+} // namespace Snake
+
+#endif
@@ -1,23 +1,31 @@
 #include "game/game_manager.hpp"
+#include "bots/autopilot.hpp"
 #include "game/level_list.hpp"
 #include "game/logic.hpp"
+#include "game/tick_schedule.hpp"
 #include "graphics/leaderboard_ui.hpp"
 #include "graphics/menu_ui.hpp"
 #include "graphics/pause_ui.hpp"
+#include "runtime/clock.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <cstdlib>
-#include <ctime>
-#include <unistd.h> //for usleep()...
+#include <cstdio>
+#include <random>
+#include <unistd.h>
 
 namespace Snake {
 
-SnakeGameManager::SnakeGameManager(uint16_t window_width, uint16_t window_height, LevelList *levels) {
-    std::srand(time(NULL));
+SnakeGameManager::SnakeGameManager(uint16_t window_width, uint16_t window_height, LevelList *levels,
+                                   const char *replay_directory, bool autopilot)
+    : input_reader(STDIN_FILENO) {
     this->level_list = levels;
+    this->replay_directory = replay_directory;
+    this->replay = nullptr;
+    this->autopilot = autopilot ? new Bots::AutopilotPolicy() : nullptr;
     this->game = nullptr;
     this->game_ui = nullptr;
+    this->input_latency = {0, 0, 0};
     this->menu_ui = new Graphics::MenuUI(window_width, window_height);
 
     this->window_height = window_height;
@@ -37,6 +45,9 @@ SnakeGameManager::~SnakeGameManager() { // destructor
     if (this->menu_ui) {
         delete this->menu_ui;
     }
+
+    delete this->replay;
+    delete this->autopilot;
 }
 
 void SnakeGameManager::start_game(GameDifficulty game_difficulty, uint32_t level_id) {
@@ -44,53 +55,80 @@ void SnakeGameManager::start_game(GameDifficulty game_difficulty, uint32_t level
     delete this->menu_ui;
     this->menu_ui = nullptr;
 
-    this->game = new Game(window_height, window_width, game_difficulty, level_id); // obj for game logic
+    // obj for game logic
+    this->game = new Game(window_height, window_width, game_difficulty, level_id, this->new_game_seed());
+    this->start_replay();
 
     assert(this->level_list->set_current_level(game_difficulty, level_id));
 
     this->game_ui = new Graphics::GameUI(this->game); // rendering a new win for the game...
 
     // game_ui window settings
-    keypad((this->game_ui)->getWindow(), true);  // for arrow keys
-    nodelay((this->game_ui)->getWindow(), true); // for non-blocking input
-    mmask_t oldmask;                             // to save the previous mouse events mask...
-    mousemask(0, &oldmask);                      // disable mouse for this win
-
-    // in microseconds
-    int32_t remaining_time = GAME_DURATION * 1'000'000;
-    // in microseconds
-    uint32_t frame_duration = this->get_frame_duration(this->level_list->get_current()->info.id);
+    keypad((this->game_ui)->getWindow(), true); // for arrow keys
+    mmask_t oldmask;                            // to save the previous mouse events mask...
+    mousemask(0, &oldmask);                     // disable mouse for this win
+    // the terminal belongs to the input reader, a refresh must not stop halfway because it has bytes
+    typeahead(-1);
+
+    // CLOCK_MONOTONIC nanoseconds
+    int64_t now = Runtime::get_monotonic_time();
+    TickSchedule schedule(this->game, now);
+    bool pause_requested = false;
+    this->turns.clear();
+    this->input_reader.start();
+    this->renderer.start(this->game_ui);
     do {
 
-        if (remaining_time <= 0) {
+        now = Runtime::get_monotonic_time();
+        if (schedule.is_time_up(this->game)) {
             this->game->win_game();
 
             LevelListElement *current_level = level_list->get_current();
             current_level->info.high_score = std::max(current_level->info.high_score, game->get_score());
 
+            this->save_replay();
+
             // if there is any remaining level
             if (this->next_level()) {
+                this->input_reader.stop();
+                this->renderer.stop();
+                this->game_ui->wait_for_user_win_screen();
 
                 delete game;
 
-                this->game = new Game(window_height, window_width, game_difficulty, level_list->get_current()->info.id);
-                this->game_ui->wait_for_user_win_screen();
+                this->game = new Game(window_height, window_width, game_difficulty, level_list->get_current()->info.id,
+                                      this->new_game_seed());
+                this->start_replay();
 
                 delete game_ui;
                 this->game_ui = new Graphics::GameUI(this->game);
 
-                remaining_time = GAME_DURATION * 1'000'000;
-                frame_duration = this->get_frame_duration(this->level_list->get_current()->info.id);
-
-                game_ui->update_game_window(GAME_DURATION);
-                nodelay((this->game_ui)->getWindow(), true);
+                now = Runtime::get_monotonic_time();
+                schedule = TickSchedule(this->game, now);
+                this->turns.clear();
+                this->input_reader.start();
+                this->renderer.start(this->game_ui);
+                this->publish_frame(GAME_DURATION);
             } else {
                 break;
             }
         }
 
-        Direction player_input = this->get_player_input();
+        int64_t typed_time;
+        Direction player_input = pause_requested ? EXIT : this->turns.pop(&typed_time);
+        pause_requested = false;
+        if (this->autopilot && player_input != EXIT) {
+            player_input = this->autopilot->next_input(this->game);
+        } else if (player_input != DIRECTION_NONE && player_input != EXIT) {
+            // only the typed turns that reach the game count as input latency
+            int64_t latency = now - typed_time;
+            this->input_latency.turn_count++;
+            this->input_latency.total_latency += latency;
+            this->input_latency.worst_latency = std::max(this->input_latency.worst_latency, latency);
+        }
         if (player_input == EXIT) {
+            this->input_reader.stop();
+            this->renderer.stop();
             Graphics::PauseUI pause_ui(window_width, window_height);
 
             mousemask(oldmask, NULL);
@@ -101,27 +139,46 @@ void SnakeGameManager::start_game(GameDifficulty game_difficulty, uint32_t level
             } else if (pause_menu_selection.action == Graphics::PAUSE_RESUME) {
                 player_input = DIRECTION_NONE;
             }
+            // wipes the pause menu now, the render thread only refreshes the game windows
             clear();
+            refresh();
             mousemask(0, &oldmask);
-            game_ui->update_game_window(remaining_time / 1'000'000);
+
+            // the turns typed before the pause are forgotten
+            this->turns.clear();
+            this->input_reader.start();
+            int64_t paused_time = Runtime::get_monotonic_time() - now;
+            schedule.delay(paused_time);
+            now += paused_time;
+
             game_ui->render_content();
+            game_ui->invalidate();
+            this->renderer.start(this->game_ui);
+            this->publish_frame(schedule.get_remaining_seconds(this->game));
         }
 
+        if (this->replay) {
+            this->replay->record_input(player_input);
+        }
         if (game->update_game(player_input) != GAME_UNFINISHED) {
             // managing the ending frame
             break;
         }
-        game_ui->update_game_window(remaining_time / 1'000'000);
-        // timer
-        // sleep(in micro-secs) to give time to see frames rendered between each loop
-        usleep(frame_duration);
-        remaining_time -= frame_duration;
+
+        schedule.advance(Runtime::get_monotonic_time());
+        // the render thread skips the frames of the ticks that run late
+        this->publish_frame(schedule.get_remaining_seconds(this->game));
+        // the pause menu shows up right away, the tick it interrupted runs when the player resumes
+        pause_requested = !this->wait_for_player_input(schedule.get_next_tick());
     } while (game->get_game_result() == GAME_UNFINISHED);
+    this->input_reader.stop();
+    this->renderer.stop();
 
     LevelListElement *current_level = level_list->get_current();
     current_level->info.high_score = std::max(current_level->info.high_score, game->get_score());
 
     level_list->save_as_file(LEVELS_FILE_NAME);
+    this->save_replay();
 
     if(game->get_game_result() == GAME_LOST) {
         game_ui->wait_for_user_loss_screen();
@@ -130,67 +187,62 @@ void SnakeGameManager::start_game(GameDifficulty game_difficulty, uint32_t level
     mousemask(oldmask, NULL); // restore mouse events
 }
 
-uint32_t SnakeGameManager::get_frame_duration(uint32_t level) {
-    uint32_t speed;
-    switch (this->game->get_game_difficulty()) {
-        // the game is made harder by making the snake move every
-        // unit of time expressed in microseconds
-        // the lower the time intervals the harder the game
-        case DIFFICULTY_EASY:
-            speed = 300000 - (level * 10000); // Lower speed
-            break;
-        case DIFFICULTY_NORMAL:
-            speed = 250000 - (level * 15000); // Moderate speed
-            break;
-        case DIFFICULTY_HARD:
-            speed = 200000 - (level * 17500); // Faster speed
-            break;
-        default:
-            speed = 125000; // Default speed
-            break;
-    }
+void SnakeGameManager::publish_frame(int32_t remaining_time) {
+    this->renderer.get_back_frame().capture(this->game, remaining_time);
+    this->renderer.publish_frame();
+}
+
+void SnakeGameManager::start_replay() {
+    delete this->replay;
+    this->replay = this->replay_directory ? Replay::for_game(this->game) : nullptr;
+}
 
-    if (speed < 50000) {
-        speed = 50000; // Cap the speed at a minimum interval (e.g., 50 ms)
+void SnakeGameManager::save_replay() {
+    if (!this->replay) {
+        return;
     }
-    return speed;
+
+    this->replay->finish(this->game);
+
+    char file_path[4096];
+    const ReplayHeader &header = this->replay->get_header();
+    std::snprintf(file_path, sizeof(file_path), "%s/replay_%d_%u_%016llx.snkr", this->replay_directory,
+                  header.difficulty, header.level, (unsigned long long)header.seed);
+    this->replay->save_as_file(file_path);
+
+    delete this->replay;
+    this->replay = nullptr;
 }
 
-Direction SnakeGameManager::get_player_input() {
-    WINDOW *game_win = (this->game_ui)->getWindow();
+uint64_t SnakeGameManager::new_game_seed() {
+    return ((uint64_t)this->seed_source() << 32) | this->seed_source();
+}
 
-    int input = wgetch(game_win); // inp for game win
+uint32_t SnakeGameManager::get_frame_duration(uint32_t level) {
+    return Snake::get_frame_duration(this->game->get_game_difficulty(), level);
+}
 
-    // TODO: maybe we should get all concurrent inputs,
-    // then find out if the player is pressing *only* one arrow,
-    // otherwise we're returning DIRECTION_NONE
-    while (wgetch(game_win) != ERR) {
-        // clearing the input buffer
+bool SnakeGameManager::read_player_input() {
+    // every key typed since the last call, so quick double turns are not lost
+    InputEvent event;
+    while (this->input_reader.pop(event)) {
+        Direction turn = to_direction(event.key);
+        if (turn == EXIT) {
+            return false;
+        }
+        this->turns.push(turn, this->game->get_current_direction(), event.time);
     }
+    return true;
+}
 
-    switch (input) {
-        case 'W':
-        case 'w':
-        case KEY_UP:
-            return DIRECTION_UP;
-        case 'S':
-        case 's':
-        case KEY_DOWN:
-            return DIRECTION_DOWN;
-        case 'D':
-        case 'd':
-        case KEY_RIGHT:
-            return DIRECTION_RIGHT;
-        case 'A':
-        case 'a':
-        case KEY_LEFT:
-            return DIRECTION_LEFT;
-        case 'Q':
-        case 'q':
-            return EXIT;
-        default:
-            return DIRECTION_NONE;
+bool SnakeGameManager::wait_for_player_input(int64_t deadline) {
+    while (this->read_player_input()) {
+        if (Runtime::get_monotonic_time() >= deadline) {
+            return true;
+        }
+        this->input_reader.wait_until(deadline);
     }
+    return false;
 }
 
 void SnakeGameManager::show_menu() {
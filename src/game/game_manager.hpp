@@ -1,14 +1,28 @@
 #ifndef SNAKE_HPP
 #define SNAKE_HPP
 
+#include "bots/policy.hpp"
+#include "game/input_reader.hpp"
 #include "game/level_list.hpp"
 #include "game/logic.hpp"
+#include "game/replay.hpp"
+#include "game/turn_queue.hpp"
+#include "graphics/game_renderer.hpp"
 #include "graphics/game_ui.hpp"
 #include "graphics/level_selection_ui.hpp"
 #include "graphics/menu_ui.hpp"
 #include <cstdint>
+#include <random>
 
 namespace Snake {
+
+// Time between a key press and the tick that applied its turn, over every turn of the program
+struct InputLatency {
+    uint64_t turn_count;
+    int64_t total_latency; // nanoseconds
+    int64_t worst_latency; // nanoseconds
+};
+
 class SnakeGameManager {
   private:
     uint16_t window_width;
@@ -18,16 +32,47 @@ class SnakeGameManager {
     Graphics::GameUI *game_ui;
     Graphics::MenuUI *menu_ui;
     Graphics::LevelSelectionUI *level_selector_ui;
+    std::random_device seed_source;  // only used to seed every new game
+    const char *replay_directory;    // nullptr if replays should not be recorded
+    Replay *replay;                  // replay of the current game, if it is being recorded
+    Bots::Policy *autopilot;         // plays instead of the player if not nullptr
+    InputReader input_reader;        // reads the terminal while a game is running
+    Graphics::GameRenderer renderer; // draws the game window while a game is running
+    TurnQueue turns;                 // typed by the player, one is applied per tick
+    InputLatency input_latency;
+
+    // Returns a fresh seed for the next game
+    uint64_t new_game_seed();
+
+    // Starts recording the current game if replays are enabled
+    void start_replay();
+    // Saves the replay of the current game inside of replay_directory
+    void save_replay();
+
+    // Hands the current state of the game to the render thread
+    void publish_frame(int32_t remaining_time);
+
+    // Queues the turns typed so far, returns false if the player asked for the pause menu
+    bool read_player_input();
+    // Queues the turns typed until CLOCK_MONOTONIC reaches deadline, in nanoseconds, sleeping in poll()
+    // on the terminal meanwhile. Returns false as soon as the player asks for the pause menu
+    bool wait_for_player_input(int64_t deadline);
 
   public:
-    SnakeGameManager(uint16_t window_width, uint16_t window_height, LevelList *levels);
+    // if replay_directory is not nullptr, a replay of every game is saved inside of it.
+    // if autopilot is true, the snake is steered by the autopilot bot and the player can only pause
+    SnakeGameManager(uint16_t window_width, uint16_t window_height, LevelList *levels,
+                     const char *replay_directory = nullptr, bool autopilot = false);
     ~SnakeGameManager();
 
     void start_game(GameDifficulty game_difficulty, uint32_t level_id);
     void show_menu();
     uint32_t get_frame_duration(uint32_t level);
     bool next_level();
-    Direction get_player_input();
+
+    InputLatency get_input_latency() const {
+        return input_latency;
+    }
 };
 
 } // namespace Snake
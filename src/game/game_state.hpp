@@ -0,0 +1,37 @@
+#ifndef GAME_STATE_HPP
+#define GAME_STATE_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace Snake {
+
+// Cells of the biggest table returned by get_playable_dimensions
+inline constexpr uint32_t GAME_STATE_MAX_CELLS = get_max_playable_cells();
+
+// Fixed size copy of everything that changes while a Game is played.
+// It is trivially copyable, so cloning a game for a search is a plain memcpy
+// of this struct and never touches the heap.
+// Cells are stored as their index inside of the playable area (y * width + x)
+struct GameState {
+    uint16_t playable_width;
+    uint16_t playable_height;
+    uint8_t game_result;
+    int8_t current_direction;
+    uint16_t apple_cell;
+    uint32_t score;
+    uint32_t tick_count;
+    uint64_t random_state[4];
+    uint16_t body_length;
+    uint16_t free_cell_count;
+    uint16_t body[GAME_STATE_MAX_CELLS];       // from the head to the tail
+    uint16_t free_cells[GAME_STATE_MAX_CELLS]; // in the order of the FreeCellSet
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState must be copyable with memcpy");
+static_assert(GAME_STATE_MAX_CELLS < UINT16_MAX, "GameState cells must fit in 16 bits");
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef INPUT_READER_CPP
+#define INPUT_READER_CPP
+
+#include "game/input_reader.hpp"
+#include "runtime/clock.hpp"
+#include <cerrno>
+#include <ctime>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace Snake {
+
+InputReader::InputReader(int fd) {
+    this->fd = fd;
+    this->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    this->notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->stop_fd < 0 || this->notify_fd < 0) {
+        close(this->stop_fd);
+        close(this->notify_fd);
+        throw std::runtime_error("Could not create the eventfds of the input reader");
+    }
+}
+
+InputReader::~InputReader() {
+    this->stop();
+    close(this->stop_fd);
+    close(this->notify_fd);
+}
+
+void InputReader::start() {
+    if (this->thread.joinable()) {
+        return;
+    }
+    this->events.clear();
+    this->thread = std::thread(&InputReader::run, this);
+}
+
+void InputReader::stop() {
+    if (!this->thread.joinable()) {
+        return;
+    }
+    uint64_t value = 1;
+    ssize_t result = write(this->stop_fd, &value, sizeof(value));
+    this->thread.join();
+    // ready for the next start()
+    result = read(this->stop_fd, &value, sizeof(value));
+    (void)result;
+}
+
+void InputReader::run() {
+    struct pollfd fds[2] = {{this->fd, POLLIN, 0}, {this->stop_fd, POLLIN, 0}};
+    uint8_t buffer[64];
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents) {
+            return;
+        }
+
+        ssize_t received = read(this->fd, buffer, sizeof(buffer));
+        if (received < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+        if (received <= 0) {
+            // the terminal is gone
+            return;
+        }
+
+        int64_t now = Runtime::get_monotonic_time();
+        bool pushed = false;
+        for (ssize_t i = 0; i < received; i++) {
+            TerminalKey key = this->decoder.feed(buffer[i]);
+            // a full ring means the game is not reading anymore, the newest keys are the ones to drop
+            if (key != TERMINAL_KEY_NONE && this->events.push({key, now})) {
+                pushed = true;
+            }
+        }
+        if (pushed) {
+            uint64_t value = 1;
+            ssize_t result = write(this->notify_fd, &value, sizeof(value));
+            (void)result;
+        }
+    }
+}
+
+void InputReader::wait_until(int64_t deadline) {
+    int64_t now = Runtime::get_monotonic_time();
+    if (now >= deadline) {
+        return;
+    }
+
+    // ppoll takes a nanosecond timeout, poll would round the deadline to milliseconds
+    struct pollfd notify = {this->notify_fd, POLLIN, 0};
+    struct timespec timeout;
+    timeout.tv_sec = (deadline - now) / 1'000'000'000;
+    timeout.tv_nsec = (deadline - now) % 1'000'000'000;
+    if (ppoll(&notify, 1, &timeout, NULL) > 0) {
+        // the keys of this notification are popped by the caller, a later push notifies again
+        uint64_t value;
+        ssize_t result = read(this->notify_fd, &value, sizeof(value));
+        (void)result;
+    }
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef INPUT_READER_HPP
+#define INPUT_READER_HPP
+
+#include "game/terminal_input.hpp"
+#include "runtime/spsc_ring.hpp"
+#include <cstdint>
+#include <thread>
+
+namespace Snake {
+
+#define INPUT_READER_CAPACITY 64
+
+struct InputEvent {
+    TerminalKey key;
+    int64_t time; // CLOCK_MONOTONIC nanoseconds, when the bytes of the key were read
+};
+
+// Reads and decodes the keys typed in the terminal on its own thread, so input is never stuck behind
+// a slow refresh of the screen. Keys reach the game thread through a wait-free ring, stamped with the
+// time they were read. Only one thread may read the terminal at a time: the reader is stopped while
+// ncurses reads it (menus, pause and end screens)
+class InputReader {
+  private:
+    int fd;
+    int stop_fd;   // eventfd written by stop()
+    int notify_fd; // eventfd written after every batch of keys
+    TerminalInput decoder;
+    Runtime::SpscRing<InputEvent, INPUT_READER_CAPACITY> events;
+    std::thread thread;
+
+    void run();
+
+  public:
+    // Reads the non ncurses owned descriptor fd, the terminal must already be in cbreak or raw mode.
+    // Throws std::runtime_error if the eventfds cannot be created
+    InputReader(int fd);
+    ~InputReader();
+
+    InputReader(const InputReader &) = delete;
+    InputReader &operator=(const InputReader &) = delete;
+
+    // Starts the thread, the keys that were not popped before the last stop() are dropped
+    void start();
+
+    // Joins the thread, the bytes it has not read stay in the terminal for the next reader
+    void stop();
+
+    // Returns the oldest key, false if there is none. Called by the game thread only
+    bool pop(InputEvent &event) {
+        return events.pop(event);
+    }
+
+    // Sleeps until a key may be ready to pop or CLOCK_MONOTONIC reaches deadline, in nanoseconds
+    void wait_until(int64_t deadline);
+};
+
+} // namespace Snake
+
+#endif
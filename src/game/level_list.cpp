@@ -133,6 +133,18 @@ bool LevelList::set_current_level(GameDifficulty difficulty, size_t index) {
     return false;
 }
 
+LevelList *LevelList::default_levels() {
+    LevelList *levels = new LevelList;
+
+    for (uint16_t i = 1; i <= 8; i++) {
+        levels->add_element(LevelInfo(0, i, DIFFICULTY_EASY));
+        levels->add_element(LevelInfo(0, i, DIFFICULTY_NORMAL));
+        levels->add_element(LevelInfo(0, i, DIFFICULTY_HARD));
+    }
+
+    return levels;
+}
+
 LevelList *LevelList::from_file(const char *file_path) {
     FILE *file = fopen(file_path, "r");
     if (file == NULL) {
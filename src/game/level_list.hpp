@@ -44,6 +44,9 @@ class LevelList {
     // Returns false otherwise
     bool set_current_level(GameDifficulty difficulty, size_t index);
 
+    // Returns the levels of a new installation, 8 for every difficulty
+    static LevelList *default_levels();
+
     static LevelList *from_file(const char *file_path);
     void save_as_file(const char *file_path);
 };
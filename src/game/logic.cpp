@@ -2,23 +2,108 @@
 #define LOGIC_CPP
 
 #include "logic.hpp"
+#include <stdexcept>
 
 namespace Snake {
 bool coordinates_are_equal(Coordinates a, Coordinates b) {
     return a.x == b.x && a.y == b.y;
 }
 
+bool is_valid_difficulty(int32_t difficulty) {
+    return find_difficulty_settings(difficulty) != nullptr;
+}
+
+bool is_valid_input(Direction input) {
+    return input == DIRECTION_NONE || input == DIRECTION_UP || input == DIRECTION_DOWN || input == DIRECTION_LEFT ||
+           input == DIRECTION_RIGHT;
+}
+
 GameTable get_playable_dimensions(GameDifficulty difficulty) {
+    const DifficultySettings *settings = find_difficulty_settings(difficulty);
+    if (!settings) {
+        return find_difficulty_settings(DIFFICULTY_NORMAL)->playable_area;
+    }
+    return settings->playable_area;
+}
+
+uint32_t get_apple_points(uint32_t level, GameDifficulty difficulty) {
+    const DifficultySettings *settings = find_difficulty_settings(difficulty);
+    if (!settings) {
+        throw std::invalid_argument("Invalid game difficulty");
+    }
+    return APPLE_BASE_POINTS * settings->apple_multiplier * level;
+}
+
+uint16_t get_initial_body_size(GameDifficulty difficulty) {
+    return 1 + SNAKE_MINIMUM_BODY_SIZE + difficulty;
+}
+
+void get_initial_snake_body(GameTable playable_area, GameDifficulty difficulty, Coordinates *parts) {
+    Coordinates snake_head_position;
+    snake_head_position.x = playable_area.width / 2;
+    snake_head_position.y = playable_area.height / 2;
+    parts[0] = snake_head_position;
+
+    uint16_t remaining_snake_body_size = SNAKE_MINIMUM_BODY_SIZE + difficulty;
+    uint16_t i = 1;
+    // Avoid asking yourself why it works
+    while (remaining_snake_body_size) {
+        Coordinates coords;
+        if (remaining_snake_body_size + snake_head_position.y >= playable_area.height - 2) {
+            coords.y = playable_area.height - 2;
+            coords.x = snake_head_position.x + remaining_snake_body_size - (coords.y - snake_head_position.y);
+
+        } else {
+            coords.x = snake_head_position.x;
+            coords.y = snake_head_position.y + remaining_snake_body_size;
+        }
+        remaining_snake_body_size--;
+        parts[i++] = coords;
+    }
+}
+
+void get_serpentine_snake_body(GameTable playable_area, uint32_t length, Coordinates *parts) {
+    const uint16_t inner_width = playable_area.width - 2;
+    for (uint32_t i = 0; i < length; i++) {
+        uint16_t row = i / inner_width;
+        uint16_t column = i % inner_width;
+        if (row % 2) {
+            // odd rows go back from right to left
+            column = inner_width - 1 - column;
+        }
+        parts[i] = {(uint16_t)(1 + column), (uint16_t)(playable_area.height - 2 - row)};
+    }
+}
+
+uint32_t get_frame_duration(GameDifficulty difficulty, uint32_t level) {
+    int64_t speed;
     switch (difficulty) {
+        // the game is made harder by making the snake move every
+        // unit of time expressed in microseconds
+        // the lower the time intervals the harder the game
         case DIFFICULTY_EASY:
-            return {30, 80};
+            speed = 300000 - ((int64_t)level * 10000); // Lower speed
+            break;
         case DIFFICULTY_NORMAL:
-            return {25, 70};
+            speed = 250000 - ((int64_t)level * 15000); // Moderate speed
+            break;
         case DIFFICULTY_HARD:
-            return {20, 60};
+            speed = 200000 - ((int64_t)level * 17500); // Faster speed
+            break;
         default:
-            return {25, 70};
+            speed = 125000; // Default speed
+            break;
+    }
+
+    if (speed < 50000) {
+        speed = 50000; // Cap the speed at a minimum interval (e.g., 50 ms)
     }
+    return speed;
+}
+
+uint32_t get_game_duration_ticks(GameDifficulty difficulty, uint32_t level) {
+    uint32_t frame_duration = get_frame_duration(difficulty, level);
+    return (GAME_DURATION * 1'000'000 + frame_duration - 1) / frame_duration;
 }
 
 } // namespace Snake
@@ -52,9 +52,75 @@ struct LevelInfo {
         this->difficulty = difficulty;
     }
 };
-// Returns the game table size for the given difficulty
+#define APPLE_BASE_POINTS 10
+#define DIFFICULTY_COUNT 3
+
+// The table size and the apple points multiplier of a difficulty
+struct DifficultySettings {
+    GameDifficulty difficulty;
+    GameTable playable_area;
+    uint32_t apple_multiplier;
+};
+
+// The settings of every difficulty, get_playable_dimensions and get_apple_points read them from here
+inline constexpr DifficultySettings DIFFICULTY_SETTINGS[DIFFICULTY_COUNT] = {
+    {DIFFICULTY_EASY, {30, 80}, 1},
+    {DIFFICULTY_NORMAL, {25, 70}, 2},
+    {DIFFICULTY_HARD, {20, 60}, 3},
+};
+
+// Returns the settings of the given difficulty, nullptr if it is not a GameDifficulty value
+constexpr const DifficultySettings *find_difficulty_settings(int32_t difficulty) {
+    for (const DifficultySettings &settings : DIFFICULTY_SETTINGS) {
+        if (settings.difficulty == difficulty) {
+            return &settings;
+        }
+    }
+    return nullptr;
+}
+
+// Returns the number of cells of the biggest table in DIFFICULTY_SETTINGS
+constexpr uint32_t get_max_playable_cells() {
+    uint32_t max_cells = 0;
+    for (const DifficultySettings &settings : DIFFICULTY_SETTINGS) {
+        uint32_t cells = (uint32_t)settings.playable_area.width * settings.playable_area.height;
+        max_cells = cells > max_cells ? cells : max_cells;
+    }
+    return max_cells;
+}
+
+// Returns the game table size for the given difficulty, the normal one if the difficulty is not valid
 GameTable get_playable_dimensions(GameDifficulty difficulty);
 
+// Returns the points awarded for eating an apple
+uint32_t get_apple_points(uint32_t level, GameDifficulty difficulty);
+
+// Returns the number of parts of a new snake
+uint16_t get_initial_body_size(GameDifficulty difficulty);
+
+// Writes the position of the parts of a new snake, from its tail to its head.
+// parts must have room for get_initial_body_size(difficulty) elements
+void get_initial_snake_body(GameTable playable_area, GameDifficulty difficulty, Coordinates *parts);
+
+// Writes the position of the parts of a snake of any length, from its tail to its head.
+// The tail is in the bottom left corner and the parts fill the rows going up, one row left to right,
+// the next one right to left. length must be lower than the number of cells inside of the borders
+void get_serpentine_snake_body(GameTable playable_area, uint32_t length, Coordinates *parts);
+
+// Returns the time between two game ticks in microseconds,
+// the lower it is the harder the game
+uint32_t get_frame_duration(GameDifficulty difficulty, uint32_t level);
+
+// Returns how many ticks a game lasts before it is won,
+// i.e. how many frames fit in GAME_DURATION
+uint32_t get_game_duration_ticks(GameDifficulty difficulty, uint32_t level);
+
+// Returns true if the value is one of the GameDifficulty values
+bool is_valid_difficulty(int32_t difficulty);
+
+// Returns true if the value is an input that Game::update_game accepts
+bool is_valid_input(Direction input);
+
 // Compares the given coordinates
 bool coordinates_are_equal(Coordinates a, Coordinates b);
 
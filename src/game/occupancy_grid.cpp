@@ -0,0 +1,45 @@
+#ifndef OCCUPANCY_GRID_CPP
+#define OCCUPANCY_GRID_CPP
+
+#include "game/occupancy_grid.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Snake {
+
+OccupancyGrid::OccupancyGrid(GameTable table) {
+    this->width = table.width;
+    this->height = table.height;
+
+    size_t cell_count = (size_t)table.width * table.height;
+    this->word_count = (cell_count + 63) / 64;
+    this->words = new uint64_t[this->word_count];
+    this->clear();
+}
+
+OccupancyGrid::~OccupancyGrid() {
+    delete[] this->words;
+}
+
+void OccupancyGrid::clear() {
+    std::memset(this->words, 0, this->word_count * sizeof(uint64_t));
+}
+
+size_t OccupancyGrid::count_occupied(Coordinates position, size_t length) const {
+    size_t cell = to_cell_index(position);
+    const size_t end = cell + length;
+    size_t count = 0;
+    while (cell < end) {
+        // whole words at a time, masking the bits outside of the range
+        size_t bit = cell & 63;
+        size_t bit_count = std::min<size_t>(64 - bit, end - cell);
+        uint64_t mask = bit_count == 64 ? UINT64_MAX : (((uint64_t)1 << bit_count) - 1) << bit;
+        count += __builtin_popcountll(this->words[cell >> 6] & mask);
+        cell += bit_count;
+    }
+    return count;
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef OCCUPANCY_GRID_HPP
+#define OCCUPANCY_GRID_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+#include <stddef.h>
+
+namespace Snake {
+
+// Bitset with one bit for every cell of a game table,
+// a set bit means that the cell is covered by the snake
+class OccupancyGrid {
+  private:
+    uint64_t *words;
+    size_t word_count;
+    uint16_t width;
+    uint16_t height;
+
+    size_t to_cell_index(Coordinates position) const {
+        return (size_t)position.y * width + position.x;
+    }
+
+  public:
+    OccupancyGrid(GameTable table);
+    ~OccupancyGrid();
+
+    OccupancyGrid(const OccupancyGrid &) = delete;
+    OccupancyGrid &operator=(const OccupancyGrid &) = delete;
+
+    bool is_occupied(Coordinates position) const {
+        size_t cell = to_cell_index(position);
+        return (words[cell >> 6] >> (cell & 63)) & 1;
+    }
+
+    void set_occupied(Coordinates position) {
+        size_t cell = to_cell_index(position);
+        words[cell >> 6] |= (uint64_t)1 << (cell & 63);
+    }
+
+    void clear_occupied(Coordinates position) {
+        size_t cell = to_cell_index(position);
+        words[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+    }
+
+    // Counts the occupied cells among length cells starting from position and going right
+    size_t count_occupied(Coordinates position, size_t length) const;
+
+    // Clears every cell
+    void clear();
+};
+} // namespace Snake
+
+#endif
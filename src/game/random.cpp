@@ -0,0 +1,22 @@
+#ifndef RANDOM_CPP
+#define RANDOM_CPP
+
+#include "game/random.hpp"
+
+namespace Snake {
+
+RandomGenerator::RandomGenerator(uint64_t seed) {
+    // splitmix64 spreads the seed over the whole state,
+    // so that even seeds like 0 or 1 give a good sequence
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9E3779B97F4A7C15;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        this->state[i] = z ^ (z >> 31);
+    }
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+
+namespace Snake {
+
+// Small and fast xoshiro256** generator.
+// Every game owns its own instance, so games never share any random state
+// and the same seed always produces the same sequence
+class RandomGenerator {
+  private:
+    uint64_t state[4];
+
+    static uint64_t rotate_left(uint64_t value, int shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+  public:
+    RandomGenerator(uint64_t seed = 0);
+
+    // Copies the whole internal state, used to save and restore games
+    void get_state(uint64_t destination[4]) const {
+        for (int i = 0; i < 4; i++) {
+            destination[i] = state[i];
+        }
+    }
+
+    void set_state(const uint64_t source[4]) {
+        for (int i = 0; i < 4; i++) {
+            state[i] = source[i];
+        }
+    }
+
+    // Returns the next 64 random bits
+    uint64_t next() {
+        const uint64_t result = rotate_left(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+
+        state[2] ^= t;
+        state[3] = rotate_left(state[3], 45);
+
+        return result;
+    }
+
+    // Returns a random number in [0, bound), bound must be greater than 0
+    uint32_t next_bounded(uint32_t bound) {
+        // multiply and shift is faster than a modulo and has a negligible bias
+        return (uint32_t)(((next() >> 32) * bound) >> 32);
+    }
+};
+} // namespace Snake
+
+#endif
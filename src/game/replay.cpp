@@ -0,0 +1,168 @@
+#ifndef REPLAY_CPP
+#define REPLAY_CPP
+
+#include "game/replay.hpp"
+#include "game/byte_stream.hpp"
+#include <cstring>
+
+namespace Snake {
+
+Replay::Replay(ReplayHeader header) {
+    this->header = header;
+    this->tick_count = 0;
+    this->result = GAME_UNFINISHED;
+    this->score = 0;
+}
+
+Replay *Replay::for_game(const Game *game) {
+    ReplayHeader header;
+    header.seed = game->get_seed();
+    header.level = game->get_level();
+    header.difficulty = game->get_game_difficulty();
+    header.table_height = game->get_game_table().height;
+    header.table_width = game->get_game_table().width;
+    return new Replay(header);
+}
+
+void Replay::record_input(Direction input) {
+    this->tick_count++;
+    if (!this->input_runs.empty() && this->input_runs.back().direction == input) {
+        this->input_runs.back().length++;
+        return;
+    }
+    this->input_runs.push_back({input, 1});
+}
+
+void Replay::finish(const Game *game) {
+    this->result = game->get_game_result();
+    this->score = game->get_score();
+}
+
+Game *Replay::create_game() const {
+    return new Game(header.table_height, header.table_width, header.difficulty, header.level, header.seed);
+}
+
+ReplayVerification Replay::verify() const {
+    ReplayVerification verification;
+
+    // no game lasts longer than its time limit, a forged replay is rejected before simulating anything
+    uint32_t duration_ticks = get_game_duration_ticks(header.difficulty, header.level);
+    uint64_t input_count = 0;
+    for (const ReplayInputRun &run : this->input_runs) {
+        input_count += run.length;
+    }
+    if (input_count != this->tick_count || this->tick_count > duration_ticks) {
+        verification.valid = false;
+        verification.simulated_ticks = 0;
+        verification.simulated_score = 0;
+        verification.simulated_result = GAME_UNFINISHED;
+        return verification;
+    }
+
+    Game *game = this->create_game();
+    for (const ReplayInputRun &run : this->input_runs) {
+        for (uint32_t i = 0; i < run.length && game->get_game_result() == GAME_UNFINISHED; i++) {
+            game->update_game(run.direction);
+        }
+    }
+
+    // games are won when the time runs out, which can only happen after enough ticks
+    if (this->result == GAME_WON && game->get_game_result() == GAME_UNFINISHED &&
+        game->get_tick_count() >= duration_ticks) {
+        game->win_game();
+    }
+
+    verification.simulated_ticks = game->get_tick_count();
+    verification.simulated_score = game->get_score();
+    verification.simulated_result = game->get_game_result();
+    // inputs recorded after the end of the game are not simulated, so the tick counts differ
+    verification.valid = verification.simulated_ticks == this->tick_count &&
+                         verification.simulated_result == this->result && verification.simulated_score == this->score;
+
+    delete game;
+    return verification;
+}
+
+void Replay::serialize(std::vector<uint8_t> &buffer) const {
+    ByteWriter writer(buffer);
+    writer.write_bytes(REPLAY_FILE_MAGIC, 4);
+    writer.write_u16(REPLAY_FILE_VERSION);
+    writer.write_u8(header.difficulty);
+    writer.write_u32(header.level);
+    writer.write_u64(header.seed);
+    writer.write_u16(header.table_height);
+    writer.write_u16(header.table_width);
+
+    writer.write_u32(this->input_runs.size());
+    for (const ReplayInputRun &run : this->input_runs) {
+        writer.write_u8((uint8_t)run.direction);
+        writer.write_varint(run.length);
+    }
+
+    writer.write_u32(this->tick_count);
+    writer.write_u8(this->result);
+    writer.write_u32(this->score);
+}
+
+Replay *Replay::deserialize(const uint8_t *data, size_t size) {
+    ByteReader reader(data, size);
+
+    char magic[4];
+    uint16_t version;
+    uint8_t difficulty;
+    ReplayHeader header;
+    if (!reader.read_bytes(magic, 4) || std::memcmp(magic, REPLAY_FILE_MAGIC, 4) != 0 ||
+        !reader.read_u16(version) || version != REPLAY_FILE_VERSION || !reader.read_u8(difficulty) ||
+        !is_valid_difficulty(difficulty) || !reader.read_u32(header.level) || !reader.read_u64(header.seed) ||
+        !reader.read_u16(header.table_height) || !reader.read_u16(header.table_width)) {
+        return nullptr;
+    }
+    header.difficulty = (GameDifficulty)difficulty;
+
+    uint32_t run_count;
+    // every run takes at least two bytes
+    if (!reader.read_u32(run_count) || run_count > reader.remaining() / 2) {
+        return nullptr;
+    }
+
+    Replay *replay = new Replay(header);
+    replay->input_runs.reserve(run_count);
+    for (uint32_t i = 0; i < run_count; i++) {
+        uint8_t direction;
+        uint64_t length;
+        if (!reader.read_u8(direction) || !is_valid_input((Direction)(int8_t)direction) || !reader.read_varint(length) ||
+            length == 0 || length > UINT32_MAX) {
+            delete replay;
+            return nullptr;
+        }
+        replay->input_runs.push_back({(Direction)(int8_t)direction, (uint32_t)length});
+    }
+
+    uint8_t result;
+    if (!reader.read_u32(replay->tick_count) || !reader.read_u8(result) || result > GAME_LOST ||
+        !reader.read_u32(replay->score)) {
+        delete replay;
+        return nullptr;
+    }
+    replay->result = (GameResult)result;
+
+    return replay;
+}
+
+Replay *Replay::from_file(const char *file_path) {
+    std::vector<uint8_t> buffer;
+    if (!read_file(file_path, buffer)) {
+        return nullptr;
+    }
+    return deserialize(buffer.data(), buffer.size());
+}
+
+bool Replay::save_as_file(const char *file_path) const {
+    std::vector<uint8_t> buffer;
+    this->serialize(buffer);
+    return write_file(file_path, buffer);
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "game/game.hpp"
+#include "game/logic.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Snake {
+
+#define REPLAY_FILE_MAGIC "SNKR"
+#define REPLAY_FILE_VERSION 1
+
+// Everything needed to build the exact same Game again
+struct ReplayHeader {
+    uint64_t seed;
+    uint32_t level;
+    GameDifficulty difficulty;
+    uint16_t table_height;
+    uint16_t table_width;
+};
+
+// The same input repeated for a certain number of consecutive ticks
+struct ReplayInputRun {
+    Direction direction;
+    uint32_t length;
+};
+
+typedef struct {
+    bool valid;
+    uint32_t simulated_ticks;
+    uint32_t simulated_score;
+    GameResult simulated_result;
+} ReplayVerification;
+
+// A recorded game: its header, the run-length encoded inputs passed to
+// Game::update_game and the final result claimed by the recorder.
+//
+// File layout (little endian):
+//   "SNKR" | version u16 | difficulty u8 | level u32 | seed u64 | table height u16 | table width u16
+//   run count u32 | run count * (direction i8, length varint)
+//   tick count u32 | result u8 | score u32
+class Replay {
+  private:
+    ReplayHeader header;
+    std::vector<ReplayInputRun> input_runs;
+    uint32_t tick_count;
+    GameResult result;
+    uint32_t score;
+
+  public:
+    Replay(ReplayHeader header);
+
+    // Starts recording the given game, no tick should have been simulated yet
+    static Replay *for_game(const Game *game);
+
+    // Appends the input of a single tick
+    void record_input(Direction input);
+
+    // Stores the final result and score of the recorded game
+    void finish(const Game *game);
+
+    // Creates the game described by the header
+    Game *create_game() const;
+
+    // Re-simulates the whole replay and checks that it reaches the claimed result and score
+    ReplayVerification verify() const;
+
+    const ReplayHeader &get_header() const {
+        return header;
+    }
+
+    const std::vector<ReplayInputRun> &get_input_runs() const {
+        return input_runs;
+    }
+
+    uint32_t get_tick_count() const {
+        return tick_count;
+    }
+
+    GameResult get_result() const {
+        return result;
+    }
+
+    uint32_t get_score() const {
+        return score;
+    }
+
+    void serialize(std::vector<uint8_t> &buffer) const;
+
+    // Returns nullptr if the buffer does not contain a valid replay
+    static Replay *deserialize(const uint8_t *data, size_t size);
+
+    // Returns nullptr if the file could not be read
+    static Replay *from_file(const char *file_path);
+    bool save_as_file(const char *file_path) const;
+};
+} // namespace Snake
+
+#endif
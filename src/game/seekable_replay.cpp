@@ -0,0 +1,240 @@
+#ifndef SEEKABLE_REPLAY_CPP
+#define SEEKABLE_REPLAY_CPP
+
+#include "game/seekable_replay.hpp"
+#include "game/byte_stream.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Snake {
+
+SeekableReplay::SeekableReplay() {
+    this->keyframe_interval = DEFAULT_KEYFRAME_INTERVAL;
+    this->tick_count = 0;
+    this->result = GAME_UNFINISHED;
+    this->score = 0;
+}
+
+SeekableReplay *SeekableReplay::from_replay(const Replay *replay, uint32_t keyframe_interval) {
+    if (keyframe_interval == 0) {
+        return nullptr;
+    }
+
+    SeekableReplay *seekable = new SeekableReplay();
+    seekable->header = replay->get_header();
+    seekable->keyframe_interval = keyframe_interval;
+    seekable->input_runs = replay->get_input_runs();
+    seekable->tick_count = replay->get_tick_count();
+    seekable->result = replay->get_result();
+    seekable->score = replay->get_score();
+
+    ByteWriter writer(seekable->data);
+    writer.write_bytes(SEEKABLE_REPLAY_FILE_MAGIC, 4);
+    writer.write_u16(SEEKABLE_REPLAY_FILE_VERSION);
+    writer.write_u8(seekable->header.difficulty);
+    writer.write_u32(seekable->header.level);
+    writer.write_u64(seekable->header.seed);
+    writer.write_u16(seekable->header.table_height);
+    writer.write_u16(seekable->header.table_width);
+    writer.write_u32(keyframe_interval);
+
+    uint64_t inputs_offset = writer.size();
+    uint32_t run_start_tick = 0;
+    for (const ReplayInputRun &run : seekable->input_runs) {
+        writer.write_u8((uint8_t)run.direction);
+        writer.write_varint(run.length);
+        seekable->run_start_ticks.push_back(run_start_tick);
+        run_start_tick += run.length;
+    }
+
+    // simulate the whole game, saving a keyframe before every keyframe_interval-th tick
+    Game *game = seekable->create_game();
+    for (const ReplayInputRun &run : seekable->input_runs) {
+        for (uint32_t i = 0; i < run.length && game->get_game_result() == GAME_UNFINISHED; i++) {
+            if (game->get_tick_count() % keyframe_interval == 0) {
+                seekable->add_keyframe(game);
+            }
+            game->update_game(run.direction);
+        }
+    }
+    if (seekable->keyframes.empty()) {
+        // nothing was played, the initial state is still needed to seek to tick 0
+        seekable->add_keyframe(game);
+    }
+    bool matches = game->get_tick_count() == seekable->tick_count;
+    delete game;
+
+    if (!matches) {
+        delete seekable;
+        return nullptr;
+    }
+
+    uint64_t footer_offset = writer.size();
+    writer.write_u32(seekable->input_runs.size());
+    writer.write_u32(seekable->keyframes.size());
+    for (const ReplayKeyframe &keyframe : seekable->keyframes) {
+        writer.write_u32(keyframe.tick);
+        writer.write_u64(keyframe.offset);
+        writer.write_u32(keyframe.size);
+    }
+    writer.write_u64(inputs_offset);
+    writer.write_u32(seekable->tick_count);
+    writer.write_u8(seekable->result);
+    writer.write_u32(seekable->score);
+
+    writer.write_u64(footer_offset);
+    writer.write_bytes(SEEKABLE_REPLAY_FILE_MAGIC, 4);
+
+    return seekable;
+}
+
+void SeekableReplay::add_keyframe(const Game *game) {
+    ReplayKeyframe keyframe;
+    keyframe.tick = game->get_tick_count();
+    keyframe.offset = this->data.size();
+    game->save_state(this->data);
+    keyframe.size = this->data.size() - keyframe.offset;
+    this->keyframes.push_back(keyframe);
+}
+
+Game *SeekableReplay::create_game() const {
+    return new Game(header.table_height, header.table_width, header.difficulty, header.level, header.seed);
+}
+
+bool SeekableReplay::seek(Game *game, uint32_t tick) const {
+    if (tick > this->tick_count) {
+        return false;
+    }
+
+    // restore the last keyframe saved before the requested tick
+    auto next_keyframe = std::upper_bound(this->keyframes.begin(), this->keyframes.end(), tick,
+                                          [](uint32_t tick, const ReplayKeyframe &keyframe) {
+                                              return tick < keyframe.tick;
+                                          });
+    const ReplayKeyframe &keyframe = *(next_keyframe - 1);
+    if (!game->load_state(this->data.data() + keyframe.offset, keyframe.size)) {
+        return false;
+    }
+
+    // then simulate the few remaining ticks
+    size_t run_index = std::upper_bound(this->run_start_ticks.begin(), this->run_start_ticks.end(), keyframe.tick) -
+                       this->run_start_ticks.begin() - 1;
+    uint32_t current_tick = keyframe.tick;
+    while (current_tick < tick && game->get_game_result() == GAME_UNFINISHED) {
+        const ReplayInputRun &run = this->input_runs[run_index];
+        uint32_t run_end_tick = this->run_start_ticks[run_index] + run.length;
+        for (; current_tick < run_end_tick && current_tick < tick; current_tick++) {
+            game->update_game(run.direction);
+        }
+        run_index++;
+    }
+
+    // the result of a game won when the time ran out is not part of any keyframe
+    if (tick == this->tick_count && this->result == GAME_WON && game->get_game_result() == GAME_UNFINISHED) {
+        game->win_game();
+    }
+    return true;
+}
+
+SeekableReplay *SeekableReplay::deserialize(const uint8_t *data, size_t size) {
+    // the tail tells where the footer starts
+    const size_t tail_size = 12;
+    uint64_t footer_offset;
+    if (size < tail_size || std::memcmp(data + size - 4, SEEKABLE_REPLAY_FILE_MAGIC, 4) != 0) {
+        return nullptr;
+    }
+    ByteReader tail_reader(data + size - tail_size, tail_size);
+    tail_reader.read_u64(footer_offset);
+    if (footer_offset > size - tail_size) {
+        return nullptr;
+    }
+
+    SeekableReplay *seekable = new SeekableReplay();
+    seekable->data.assign(data, data + size);
+
+    char magic[4];
+    uint16_t version;
+    uint8_t difficulty;
+    ByteReader header_reader(data, footer_offset);
+    if (!header_reader.read_bytes(magic, 4) || std::memcmp(magic, SEEKABLE_REPLAY_FILE_MAGIC, 4) != 0 ||
+        !header_reader.read_u16(version) || version != SEEKABLE_REPLAY_FILE_VERSION ||
+        !header_reader.read_u8(difficulty) || !is_valid_difficulty(difficulty) ||
+        !header_reader.read_u32(seekable->header.level) || !header_reader.read_u64(seekable->header.seed) ||
+        !header_reader.read_u16(seekable->header.table_height) ||
+        !header_reader.read_u16(seekable->header.table_width) ||
+        !header_reader.read_u32(seekable->keyframe_interval) || seekable->keyframe_interval == 0) {
+        delete seekable;
+        return nullptr;
+    }
+    seekable->header.difficulty = (GameDifficulty)difficulty;
+
+    ByteReader footer_reader(data + footer_offset, size - tail_size - footer_offset);
+    uint32_t run_count, keyframe_count;
+    if (!footer_reader.read_u32(run_count) || !footer_reader.read_u32(keyframe_count) || keyframe_count == 0 ||
+        keyframe_count > footer_reader.remaining() / 16) {
+        delete seekable;
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < keyframe_count; i++) {
+        ReplayKeyframe keyframe;
+        footer_reader.read_u32(keyframe.tick);
+        footer_reader.read_u64(keyframe.offset);
+        footer_reader.read_u32(keyframe.size);
+        bool ordered =
+            seekable->keyframes.empty() ? keyframe.tick == 0 : keyframe.tick > seekable->keyframes.back().tick;
+        if (!ordered || keyframe.offset > footer_offset || keyframe.size > footer_offset - keyframe.offset) {
+            delete seekable;
+            return nullptr;
+        }
+        seekable->keyframes.push_back(keyframe);
+    }
+
+    uint64_t inputs_offset;
+    uint8_t result;
+    if (!footer_reader.read_u64(inputs_offset) || inputs_offset > footer_offset ||
+        !footer_reader.read_u32(seekable->tick_count) || !footer_reader.read_u8(result) || result > GAME_LOST ||
+        !footer_reader.read_u32(seekable->score)) {
+        delete seekable;
+        return nullptr;
+    }
+    seekable->result = (GameResult)result;
+
+    ByteReader inputs_reader(data + inputs_offset, footer_offset - inputs_offset);
+    uint64_t run_start_tick = 0;
+    for (uint32_t i = 0; i < run_count; i++) {
+        uint8_t direction;
+        uint64_t length;
+        if (!inputs_reader.read_u8(direction) || !is_valid_input((Direction)(int8_t)direction) ||
+            !inputs_reader.read_varint(length) || length == 0 || run_start_tick + length > UINT32_MAX) {
+            delete seekable;
+            return nullptr;
+        }
+        seekable->input_runs.push_back({(Direction)(int8_t)direction, (uint32_t)length});
+        seekable->run_start_ticks.push_back(run_start_tick);
+        run_start_tick += length;
+    }
+
+    if (run_start_tick != seekable->tick_count || seekable->keyframes.back().tick > seekable->tick_count) {
+        delete seekable;
+        return nullptr;
+    }
+
+    return seekable;
+}
+
+SeekableReplay *SeekableReplay::from_file(const char *file_path) {
+    std::vector<uint8_t> buffer;
+    if (!read_file(file_path, buffer)) {
+        return nullptr;
+    }
+    return deserialize(buffer.data(), buffer.size());
+}
+
+bool SeekableReplay::save_as_file(const char *file_path) const {
+    return write_file(file_path, this->data);
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef SEEKABLE_REPLAY_HPP
+#define SEEKABLE_REPLAY_HPP
+
+#include "game/game.hpp"
+#include "game/replay.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Snake {
+
+#define SEEKABLE_REPLAY_FILE_MAGIC "SNKS"
+#define SEEKABLE_REPLAY_FILE_VERSION 1
+#define DEFAULT_KEYFRAME_INTERVAL 256
+
+// Full game state saved before a certain tick
+struct ReplayKeyframe {
+    uint32_t tick;
+    uint64_t offset; // position of the state inside of the file
+    uint32_t size;
+};
+
+// A replay that also stores a full Game state every keyframe_interval ticks,
+// so any tick can be reached by restoring the nearest keyframe and
+// simulating at most keyframe_interval - 1 ticks.
+//
+// File layout (little endian):
+//   "SNKS" | version u16 | difficulty u8 | level u32 | seed u64 | table height u16 | table width u16
+//   keyframe interval u32
+//   input runs: run count * (direction i8, length varint)
+//   keyframes: keyframe count * state saved by Game::save_state
+//   footer: run count u32 | keyframe count u32 | keyframe count * (tick u32, offset u64, size u32)
+//           inputs offset u64 | tick count u32 | result u8 | score u32
+//   footer offset u64 | "SNKS"
+class SeekableReplay {
+  private:
+    ReplayHeader header;
+    uint32_t keyframe_interval;
+    std::vector<ReplayInputRun> input_runs;
+    std::vector<uint32_t> run_start_ticks; // first tick of every input run
+    std::vector<ReplayKeyframe> keyframes;
+    std::vector<uint8_t> data; // the whole serialized replay
+    uint32_t tick_count;
+    GameResult result;
+    uint32_t score;
+
+    SeekableReplay();
+
+    // Appends the current state of the game to data
+    void add_keyframe(const Game *game);
+
+  public:
+    // Re-simulates the replay and stores a keyframe every keyframe_interval ticks.
+    // Returns nullptr if the replay does not match its own simulation
+    static SeekableReplay *from_replay(const Replay *replay, uint32_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // Creates the game described by the header, at tick 0
+    Game *create_game() const;
+
+    // Moves a game created by create_game() to the state right after the given tick.
+    // Returns false if the tick is past the end of the replay
+    bool seek(Game *game, uint32_t tick) const;
+
+    const ReplayHeader &get_header() const {
+        return header;
+    }
+
+    uint32_t get_keyframe_interval() const {
+        return keyframe_interval;
+    }
+
+    size_t get_keyframe_count() const {
+        return keyframes.size();
+    }
+
+    uint32_t get_tick_count() const {
+        return tick_count;
+    }
+
+    GameResult get_result() const {
+        return result;
+    }
+
+    uint32_t get_score() const {
+        return score;
+    }
+
+    const std::vector<uint8_t> &serialize() const {
+        return data;
+    }
+
+    // Returns nullptr if the buffer does not contain a valid seekable replay
+    static SeekableReplay *deserialize(const uint8_t *data, size_t size);
+
+    // Returns nullptr if the file could not be read
+    static SeekableReplay *from_file(const char *file_path);
+    bool save_as_file(const char *file_path) const;
+};
+} // namespace Snake
+
+#endif
@@ -4,84 +4,53 @@
 #include "game/snake_body.hpp"
 #include "game/logic.hpp"
 #include <cstddef>
+#include <stdexcept>
 namespace Snake {
 
-SnakeBody::SnakeBody(Coordinates head_position) {
-    head = new SnakePart;
-    head->position = head_position;
-    head->next = nullptr;
+SnakeBody::SnakeBody(Coordinates head_position, size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("The snake body capacity should be at least 1");
+    }
+    this->parts = new Coordinates[capacity];
+    this->capacity = capacity;
+    this->head_index = 0;
+    this->length = 1;
+    this->parts[0] = head_position;
 }
 
 SnakeBody::~SnakeBody() {
-    while (head) {
-        SnakePart *current = head;
-        head = head->next;
-        delete current;
-    }
+    delete[] this->parts;
 }
 
-void SnakeBody::enqueue(Snake::Coordinates position) {
-    SnakePart *new_elem = new SnakePart;
-    new_elem->position = position;
-    new_elem->next = this->head;
-
-    this->head = new_elem;
+void SnakeBody::reset(Coordinates head_position) {
+    this->head_index = 0;
+    this->length = 1;
+    this->parts[0] = head_position;
 }
 
-SnakePart *SnakeBody::dequeue() {
-    if(!this->head){
-        return nullptr;
-    }
-
-    if(!this->head->next) {
-        SnakePart *elem = this->head;
-        this->head = nullptr;
-        return elem;
-    }
-
-    SnakePart* current = this->head;
-    while (current->next->next) {
-        current = current->next;
+void SnakeBody::enqueue(Snake::Coordinates position) {
+    if (this->length == this->capacity) {
+        throw std::length_error("The snake body is already at full capacity");
     }
 
-    SnakePart *elem = current->next;
-    current->next = nullptr;
-    return elem;
-
-}
-
-size_t SnakeBody::size() {
-    size_t count = 0;
-    SnakePart *current = head;
-    while (current) {
-        ++count;
-        current = current->next;
+    this->head_index++;
+    if (this->head_index == this->capacity) {
+        this->head_index = 0;
     }
-    return count;
+    this->parts[this->head_index] = position;
+    this->length++;
 }
 
-// Method to get an element at a specific index in the queue
-SnakePart *SnakeBody::get_element_at(size_t index) {
-    if (!head) {
-        return nullptr; // Empty queue
+Coordinates SnakeBody::dequeue() {
+    if (!this->length) {
+        throw std::out_of_range("Cannot dequeue from an empty snake body");
     }
 
-    SnakePart *current = head;
-    size_t current_index = 0;
-
-    while (current) {
-        if (current_index == index) {
-            return current; // Return element at specified index
-        }
-        current_index++;
-        current = current->next;
-    }
-    return nullptr; // Return nullptr if index is out of bounds
-}
-SnakePart *SnakeBody::get_head() {
-    return this->head;
+    Coordinates tail = this->get_tail();
+    this->length--;
+    return tail;
 }
 
 } // namespace Snake
 
-#endif
\ No newline at end of file
+#endif
@@ -6,26 +6,94 @@
 
 namespace Snake {
 
-struct SnakePart {
-    Coordinates position;
-    SnakePart *next;
-};
-
+// Fixed-capacity ring buffer holding the snake's body.
+// Index 0 is the head, size() - 1 is the tail.
+// Every operation is O(1) and no allocation happens after construction
 class SnakeBody {
   private:
-    SnakePart *head;
+    Coordinates *parts;
+    size_t capacity;
+    size_t head_index; // position of the head inside of parts
+    size_t length;
+
+    // Maps a body index (0 = head) to a position inside of parts
+    size_t to_buffer_index(size_t index) const {
+        return index <= head_index ? head_index - index : head_index + capacity - index;
+    }
 
   public:
-    SnakeBody(Coordinates head_position);
+    class Iterator {
+      private:
+        const SnakeBody *body;
+        size_t index;
+
+      public:
+        Iterator(const SnakeBody *body, size_t index) : body(body), index(index) {
+        }
+
+        Coordinates operator*() const {
+            return body->parts[body->to_buffer_index(index)];
+        }
+
+        Iterator &operator++() {
+            index++;
+            return *this;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return index != other.index;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return index == other.index;
+        }
+    };
+
+    // capacity is the maximum number of parts the body can ever hold,
+    // usually the number of cells inside of the playable area
+    SnakeBody(Coordinates head_position, size_t capacity);
     ~SnakeBody();
 
+    SnakeBody(const SnakeBody &) = delete;
+    SnakeBody &operator=(const SnakeBody &) = delete;
+
+    // Replaces the whole body with a single part
+    void reset(Coordinates head_position);
+
+    // Adds a new head
     void enqueue(Snake::Coordinates position);
-    SnakePart *dequeue();
+    // Removes the tail and returns its position
+    Coordinates dequeue();
+
+    // Returns the element at a specific index, 0 is the head
+    Coordinates get_element_at(size_t index) const {
+        return parts[to_buffer_index(index)];
+    }
+
+    Coordinates get_head() const {
+        return parts[head_index];
+    }
+
+    Coordinates get_tail() const {
+        return get_element_at(length - 1);
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    size_t get_capacity() const {
+        return capacity;
+    }
+
+    // Iterates from the head to the tail
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
 
-    // Method to get an element at a specific index in the queue
-    SnakePart *get_element_at(size_t index);
-    SnakePart *get_head();
-    size_t size();
+    Iterator end() const {
+        return Iterator(this, length);
+    }
 };
 } // namespace Snake
-#endif
\ No newline at end of file
+#endif
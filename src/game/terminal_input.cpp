@@ -0,0 +1,92 @@
+#ifndef TERMINAL_INPUT_CPP
+#define TERMINAL_INPUT_CPP
+
+#include "game/terminal_input.hpp"
+
+namespace Snake {
+
+TerminalInput::TerminalInput() {
+    this->state = STATE_GROUND;
+}
+
+TerminalKey TerminalInput::feed(uint8_t byte) {
+    switch (this->state) {
+        case STATE_ESCAPE:
+            if (byte == '[' || byte == 'O') {
+                this->state = STATE_SEQUENCE;
+                return TERMINAL_KEY_NONE;
+            }
+            // a lone ESC, the byte after it is a key of its own
+            this->state = STATE_GROUND;
+            break;
+        case STATE_SEQUENCE:
+            // parameters and intermediate bytes until the final byte
+            if (byte < 0x40 || byte > 0x7e) {
+                return TERMINAL_KEY_NONE;
+            }
+            this->state = STATE_GROUND;
+            switch (byte) {
+                case 'A':
+                    return TERMINAL_KEY_UP;
+                case 'B':
+                    return TERMINAL_KEY_DOWN;
+                case 'C':
+                    return TERMINAL_KEY_RIGHT;
+                case 'D':
+                    return TERMINAL_KEY_LEFT;
+                default:
+                    return TERMINAL_KEY_NONE;
+            }
+        default:
+            break;
+    }
+
+    switch (byte) {
+        case 0x1b:
+            this->state = STATE_ESCAPE;
+            return TERMINAL_KEY_NONE;
+        case 'W':
+        case 'w':
+            return TERMINAL_KEY_UP;
+        case 'S':
+        case 's':
+            return TERMINAL_KEY_DOWN;
+        case 'D':
+        case 'd':
+            return TERMINAL_KEY_RIGHT;
+        case 'A':
+        case 'a':
+            return TERMINAL_KEY_LEFT;
+        case '\r':
+        case '\n':
+            return TERMINAL_KEY_ENTER;
+        case 'Q':
+        case 'q':
+        case 0x03: // Ctrl-C and Ctrl-D reach us as bytes in raw mode
+        case 0x04:
+            return TERMINAL_KEY_QUIT;
+        default:
+            return TERMINAL_KEY_NONE;
+    }
+}
+
+Direction to_direction(TerminalKey key) {
+    switch (key) {
+        case TERMINAL_KEY_UP:
+            return DIRECTION_UP;
+        case TERMINAL_KEY_DOWN:
+            return DIRECTION_DOWN;
+        case TERMINAL_KEY_LEFT:
+            return DIRECTION_LEFT;
+        case TERMINAL_KEY_RIGHT:
+            return DIRECTION_RIGHT;
+        case TERMINAL_KEY_QUIT:
+            return EXIT;
+        default:
+            return DIRECTION_NONE;
+    }
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TERMINAL_INPUT_HPP
+#define TERMINAL_INPUT_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+
+namespace Snake {
+
+typedef enum : uint8_t {
+    TERMINAL_KEY_NONE, // nothing complete yet, or a key the game does not use
+    TERMINAL_KEY_UP,
+    TERMINAL_KEY_DOWN,
+    TERMINAL_KEY_LEFT,
+    TERMINAL_KEY_RIGHT,
+    TERMINAL_KEY_ENTER,
+    TERMINAL_KEY_QUIT,
+} TerminalKey;
+
+// Turns the bytes typed in a raw mode terminal into keys, one byte at a time, so escape sequences
+// split between two reads are still recognized. Arrows come as ESC [ A or ESC O A, and the other
+// CSI sequences (e.g. function keys) are skipped whole
+class TerminalInput {
+  private:
+    typedef enum : uint8_t {
+        STATE_GROUND,
+        STATE_ESCAPE,   // after ESC
+        STATE_SEQUENCE, // after ESC [ or ESC O, until the final byte
+    } State;
+
+    State state;
+
+  public:
+    TerminalInput();
+
+    TerminalKey feed(uint8_t byte);
+};
+
+// Arrows and WASD turn, Q exits
+Direction to_direction(TerminalKey key);
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef TICK_SCHEDULE_CPP
+#define TICK_SCHEDULE_CPP
+
+#include "game/tick_schedule.hpp"
+#include "game/logic.hpp"
+
+namespace Snake {
+
+TickSchedule::TickSchedule(const Game *game, int64_t now) {
+    this->frame_duration = get_frame_duration(game->get_game_difficulty(), game->get_level()) * 1000ll;
+    this->next_tick = now;
+    this->duration_ticks = get_game_duration_ticks(game->get_game_difficulty(), game->get_level());
+    this->dropped_ticks = 0;
+}
+
+void TickSchedule::advance(int64_t now) {
+    this->next_tick += this->frame_duration;
+    int64_t late = now - this->next_tick;
+    if (late > MAX_CATCH_UP_TICKS * this->frame_duration) {
+        this->dropped_ticks += late / this->frame_duration;
+        this->next_tick = now;
+    }
+}
+
+int32_t TickSchedule::get_remaining_seconds(const Game *game) const {
+    int64_t remaining_time = GAME_DURATION * 1'000'000'000ll - game->get_tick_count() * this->frame_duration;
+    return remaining_time > 0 ? (int32_t)(remaining_time / 1'000'000'000) : 0;
+}
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef TICK_SCHEDULE_HPP
+#define TICK_SCHEDULE_HPP
+
+#include "game/game.hpp"
+#include <cstdint>
+
+namespace Snake {
+
+// When the loop is late (a stalled process, a slow autopilot), the ticks it missed run back to back.
+// Past this many missed ticks they are dropped instead, so the snake does not jump across the table
+#define MAX_CATCH_UP_TICKS 4
+
+// Deadlines of the ticks of a local game, in CLOCK_MONOTONIC nanoseconds.
+// Ticks follow absolute deadlines, so the time spent drawing does not delay the next one.
+// The game lasts get_game_duration_ticks ticks and not a wall clock time: dropped ticks make it end later,
+// and the replay of a won game always holds every one of its ticks
+class TickSchedule {
+  private:
+    int64_t frame_duration;
+    int64_t next_tick;
+    uint32_t duration_ticks;
+    uint64_t dropped_ticks;
+
+  public:
+    // The first tick is due at now
+    TickSchedule(const Game *game, int64_t now);
+
+    // Moves on to the deadline of the tick after the one that just ran, now is the time it ended
+    void advance(int64_t now);
+
+    // Pushes the next deadline back, e.g. by the time spent in the pause menu
+    void delay(int64_t duration) {
+        next_tick += duration;
+    }
+
+    // Returns true once the game has run all of its ticks
+    bool is_time_up(const Game *game) const {
+        return game->get_tick_count() >= duration_ticks;
+    }
+
+    // Whole seconds left before the time is up, as shown by the game window
+    int32_t get_remaining_seconds(const Game *game) const;
+
+    int64_t get_next_tick() const {
+        return next_tick;
+    }
+
+    uint64_t get_dropped_ticks() const {
+        return dropped_ticks;
+    }
+};
+
+} // namespace Snake
+
+#endif
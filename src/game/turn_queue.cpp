@@ -0,0 +1,46 @@
+#ifndef TURN_QUEUE_CPP
+#define TURN_QUEUE_CPP
+
+#include "game/turn_queue.hpp"
+
+namespace Snake {
+
+TurnQueue::TurnQueue() {
+    this->first = 0;
+    this->count = 0;
+}
+
+bool TurnQueue::push(Direction turn, Direction heading, int64_t time) {
+    if (this->count == TURN_QUEUE_CAPACITY || turn == DIRECTION_NONE || !is_valid_input(turn)) {
+        return false;
+    }
+    if (this->count > 0) {
+        heading = this->turns[(this->first + this->count - 1) % TURN_QUEUE_CAPACITY];
+    }
+    if (turn == heading || turn == ~heading) {
+        return false;
+    }
+
+    uint8_t last = (this->first + this->count) % TURN_QUEUE_CAPACITY;
+    this->turns[last] = turn;
+    this->times[last] = time;
+    this->count++;
+    return true;
+}
+
+Direction TurnQueue::pop(int64_t *time) {
+    if (this->count == 0) {
+        return DIRECTION_NONE;
+    }
+    Direction turn = this->turns[this->first];
+    if (time) {
+        *time = this->times[this->first];
+    }
+    this->first = (this->first + 1) % TURN_QUEUE_CAPACITY;
+    this->count--;
+    return turn;
+}
+
+} // namespace Snake
+
+#endif
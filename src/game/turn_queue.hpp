@@ -0,0 +1,44 @@
+#ifndef TURN_QUEUE_HPP
+#define TURN_QUEUE_HPP
+
+#include "game/logic.hpp"
+#include <cstdint>
+
+namespace Snake {
+
+#define TURN_QUEUE_CAPACITY 4
+
+// Turns typed by the player that Game::update_game has not applied yet, one is applied per tick.
+// Only the turns that change the heading the snake will have when they are applied are kept,
+// so a quick up then left within one tick turns twice instead of losing the second key
+class TurnQueue {
+  private:
+    Direction turns[TURN_QUEUE_CAPACITY];
+    int64_t times[TURN_QUEUE_CAPACITY]; // when each turn was typed, for latency accounting
+    uint8_t first;
+    uint8_t count;
+
+  public:
+    TurnQueue();
+
+    // Queues the turn if it is neither the heading of the snake after the queued turns nor its opposite.
+    // heading is the current direction of the snake. Returns false if the turn was dropped,
+    // which is also the case when the queue is full: the keys typed first win
+    bool push(Direction turn, Direction heading, int64_t time = 0);
+
+    // Returns the oldest turn, or DIRECTION_NONE if there is none.
+    // If time is not nullptr, it receives the time given to push()
+    Direction pop(int64_t *time = nullptr);
+
+    void clear() {
+        count = 0;
+    }
+
+    bool is_empty() const {
+        return count == 0;
+    }
+};
+
+} // namespace Snake
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef FRAME_SNAPSHOT_CPP
+#define FRAME_SNAPSHOT_CPP
+
+#include "graphics/frame_snapshot.hpp"
+
+namespace Graphics {
+
+void FrameSnapshot::capture(const Snake::Game *game, int32_t remaining_time) {
+    const Snake::SnakeBody *snake_body = game->get_snake_body();
+    this->snake.clear();
+    for (Snake::SnakeBody::Iterator body_part = snake_body->begin(); body_part != snake_body->end(); ++body_part) {
+        this->snake.push_back(*body_part);
+    }
+    this->apple = game->get_apple_position();
+    this->score = game->get_score();
+    this->remaining_time = remaining_time;
+    this->tick = game->get_tick_count();
+}
+
+} // namespace Graphics
+
+#endif
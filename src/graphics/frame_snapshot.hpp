@@ -0,0 +1,25 @@
+#ifndef FRAME_SNAPSHOT_HPP
+#define FRAME_SNAPSHOT_HPP
+
+#include "game/game.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Graphics {
+
+// Everything the game window shows for one tick, copied from the game by the simulation,
+// so drawing never reads a Game that is being updated
+struct FrameSnapshot {
+    std::vector<Snake::Coordinates> snake; // head first
+    Snake::Coordinates apple;
+    uint32_t score;
+    int32_t remaining_time; // seconds
+    uint32_t tick;          // Game::get_tick_count, consecutive frames differ by one step of the snake
+
+    // Overwrites the snapshot with the current state of the game, reusing the memory of the previous one
+    void capture(const Snake::Game *game, int32_t remaining_time);
+};
+
+} // namespace Graphics
+
+#endif
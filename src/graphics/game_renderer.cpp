@@ -0,0 +1,76 @@
+#ifndef GAME_RENDERER_CPP
+#define GAME_RENDERER_CPP
+
+#include "graphics/game_renderer.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace Graphics {
+
+GameRenderer::GameRenderer() : stopping(false) {
+    this->game_ui = nullptr;
+    this->notify_fd = eventfd(0, EFD_CLOEXEC);
+    if (this->notify_fd < 0) {
+        throw std::runtime_error("Could not create the eventfd of the game renderer");
+    }
+}
+
+GameRenderer::~GameRenderer() {
+    this->stop();
+    close(this->notify_fd);
+}
+
+void GameRenderer::start(GameUI *game_ui) {
+    if (this->thread.joinable()) {
+        return;
+    }
+    this->game_ui = game_ui;
+    this->stopping = false;
+    this->thread = std::thread(&GameRenderer::run, this);
+}
+
+void GameRenderer::stop() {
+    if (!this->thread.joinable()) {
+        return;
+    }
+    this->stopping = true;
+    uint64_t value = 1;
+    ssize_t result = write(this->notify_fd, &value, sizeof(value));
+    (void)result;
+    this->thread.join();
+}
+
+void GameRenderer::publish_frame() {
+    this->frames.publish();
+    uint64_t value = 1;
+    ssize_t result = write(this->notify_fd, &value, sizeof(value));
+    (void)result;
+}
+
+void GameRenderer::run() {
+    while (true) {
+        // blocks until at least one frame was published or stop() was called
+        uint64_t value;
+        if (read(this->notify_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+            continue;
+        }
+
+        // read before the acquire: the frames published before stop() are then acquired below,
+        // even those published while the previous frame was drawn
+        bool stop_requested = this->stopping;
+
+        // the frames published while the last one was drawn are all behind the latest one
+        if (this->frames.acquire()) {
+            this->game_ui->update_game_window(this->frames.get_front());
+        }
+        if (stop_requested) {
+            return;
+        }
+    }
+}
+
+} // namespace Graphics
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef GAME_RENDERER_HPP
+#define GAME_RENDERER_HPP
+
+#include "graphics/frame_snapshot.hpp"
+#include "graphics/game_ui.hpp"
+#include "runtime/triple_buffer.hpp"
+#include <atomic>
+#include <thread>
+
+namespace Graphics {
+
+// Draws the game window on its own thread, so a slow terminal never delays a tick.
+// Every tick the simulation captures a FrameSnapshot in the back buffer of a triple buffer and publishes it,
+// the render thread draws the latest published one and skips those it had no time for.
+// ncurses is not thread safe: while the renderer runs, no other thread may touch the screen
+class GameRenderer {
+  private:
+    Runtime::TripleBuffer<FrameSnapshot> frames;
+    GameUI *game_ui;
+    int notify_fd; // eventfd written by publish_frame() and stop()
+    std::atomic<bool> stopping;
+    std::thread thread;
+
+    void run();
+
+  public:
+    // Throws std::runtime_error if the eventfd cannot be created
+    GameRenderer();
+    ~GameRenderer();
+
+    GameRenderer(const GameRenderer &) = delete;
+    GameRenderer &operator=(const GameRenderer &) = delete;
+
+    // Starts drawing the published frames into game_ui, which must outlive stop()
+    void start(GameUI *game_ui);
+
+    // Draws the last published frame if it was not drawn yet, then joins the thread
+    void stop();
+
+    // Simulation side: the snapshot to fill, then publish_frame()
+    FrameSnapshot &get_back_frame() {
+        return frames.get_back();
+    }
+
+    void publish_frame();
+};
+
+} // namespace Graphics
+
+#endif
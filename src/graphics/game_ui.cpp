@@ -17,6 +17,7 @@ const char *ascii_art[24] = {
 };
 GameUI::GameUI(Snake::Game *game) {
     this->game = game;
+    this->screen_is_valid = false;
 
     Snake::GameTable game_table = game->get_game_table();
 
@@ -64,18 +65,44 @@ void GameUI::render_content() {
     wrefresh(this->window);
 }
 
-void GameUI::update_game_window(int32_t remaining_time) {
-    // Clear the window
-    // werase(this->window);
-    // box(this->window, 0, 0);
+void GameUI::invalidate() {
+    this->screen_is_valid = false;
+}
+
+void GameUI::update_game_window(const FrameSnapshot &frame) {
+    // frames the render thread skipped leave more than one step to draw
+    if (this->screen_is_valid && frame.tick == this->drawn_tick + 1 && frame.snake.size() == this->drawn_length) {
+        this->draw_changed_cells(frame);
+    } else {
+        this->draw_whole_frame(frame);
+    }
 
+    this->screen_is_valid = true;
+    this->drawn_tick = frame.tick;
+    this->drawn_length = frame.snake.size();
+    this->drawn_head = frame.snake.front();
+    this->drawn_tail = frame.snake.back();
+    this->drawn_apple = frame.apple;
+
+    // one write to the terminal for both windows
+    wnoutrefresh(this->window);
+    wnoutrefresh(this->game_window);
+    doupdate();
+}
+
+void GameUI::draw_status(const FrameSnapshot &frame) {
     // Rendering the time and score
     wattron(this->window, A_BOLD | COLOR_PAIR(YELLOW_TEXT));
-    mvwprintw(this->window, 0, 2, "Score: %5u", this->game->get_score());
-    mvwprintw(this->window, 0, getmaxx(window) - 12, "Time: %3d", remaining_time);
+    mvwprintw(this->window, 0, 2, "Score: %5u", frame.score);
+    mvwprintw(this->window, 0, getmaxx(window) - 12, "Time: %3d", frame.remaining_time);
     wattroff(this->window, A_BOLD | COLOR_PAIR(YELLOW_TEXT));
 
-    wrefresh(this->window);
+    this->drawn_score = frame.score;
+    this->drawn_time = frame.remaining_time;
+}
+
+void GameUI::draw_whole_frame(const FrameSnapshot &frame) {
+    this->draw_status(frame);
 
     werase(this->game_window);
     // borders
@@ -85,25 +112,47 @@ void GameUI::update_game_window(int32_t remaining_time) {
 
     // Rendering the apple
     wattron(this->game_window, COLOR_PAIR(RED_TEXT) | A_BOLD);
-    Snake::Coordinates apple_position = this->game->get_apple_position();
-    mvwaddch(this->game_window, apple_position.y, apple_position.x, 'o');
+    mvwaddch(this->game_window, frame.apple.y, frame.apple.x, 'o');
     wattroff(this->game_window, COLOR_PAIR(RED_TEXT) | A_BOLD);
 
     // Rendering the snake
     wattron(this->game_window, COLOR_PAIR(GREEN_TEXT));
-    Snake::Coordinates snake_head = this->game->get_snake_body()->get_head()->position;
+    Snake::Coordinates snake_head = frame.snake[0];
     mvwaddch(this->game_window, snake_head.y, snake_head.x,
              '@'); // @ head (ACS characters display incorrectly)
 
-    for (uint16_t i = 1; i < this->game->get_snake_body()->size(); ++i) {
-        Snake::Coordinates coord = this->game->get_snake_body()->get_element_at(i)->position;
+    for (size_t i = 1; i < frame.snake.size(); i++) {
+        Snake::Coordinates coord = frame.snake[i];
         mvwaddch(this->game_window, coord.y, coord.x, '#'); // # body
     }
     wattroff(this->game_window, COLOR_PAIR(GREEN_TEXT));
     curs_set(0);
 
-    wrefresh(this->game_window);
-    refresh();
+    // the windows may have been covered, the whole of them goes to the terminal
+    touchwin(this->window);
+    touchwin(this->game_window);
+}
+
+void GameUI::draw_changed_cells(const FrameSnapshot &frame) {
+    if (frame.score != this->drawn_score || frame.remaining_time != this->drawn_time) {
+        this->draw_status(frame);
+    }
+
+    // the snake moved by one cell and never grows: its old tail is free, unless the new head took it,
+    // which is why the head is drawn after. An eaten apple is under the new head as well
+    if (!Snake::coordinates_are_equal(frame.apple, this->drawn_apple)) {
+        mvwaddch(this->game_window, this->drawn_apple.y, this->drawn_apple.x, ' ');
+    }
+    mvwaddch(this->game_window, this->drawn_tail.y, this->drawn_tail.x, ' ');
+
+    wattron(this->game_window, COLOR_PAIR(RED_TEXT) | A_BOLD);
+    mvwaddch(this->game_window, frame.apple.y, frame.apple.x, 'o');
+    wattroff(this->game_window, COLOR_PAIR(RED_TEXT) | A_BOLD);
+
+    wattron(this->game_window, COLOR_PAIR(GREEN_TEXT));
+    mvwaddch(this->game_window, this->drawn_head.y, this->drawn_head.x, '#');
+    mvwaddch(this->game_window, frame.snake[0].y, frame.snake[0].x, '@');
+    wattroff(this->game_window, COLOR_PAIR(GREEN_TEXT));
 }
 
 void GameUI::wait_for_user_win_screen() {
@@ -2,6 +2,7 @@
 #define GAME_UI_HPP
 
 #include "game/game.hpp"
+#include "graphics/frame_snapshot.hpp"
 
 #ifdef _WIN32
 #include <ncurses/ncurses.h>
@@ -17,11 +18,30 @@ class GameUI {
     WINDOW *game_window;
     Snake::Game *game;
 
+    // What the screen shows, so a frame that follows it only draws the cells that changed
+    bool screen_is_valid; // false until the first frame and after invalidate()
+    uint32_t drawn_tick;
+    size_t drawn_length;
+    Snake::Coordinates drawn_head;
+    Snake::Coordinates drawn_tail;
+    Snake::Coordinates drawn_apple;
+    uint32_t drawn_score;
+    int32_t drawn_time;
+
+    void draw_status(const FrameSnapshot &frame);
+    void draw_whole_frame(const FrameSnapshot &frame);
+    void draw_changed_cells(const FrameSnapshot &frame);
+
   public:
     GameUI(Snake::Game *game);
     ~GameUI();
 
-    void update_game_window(int32_t remaining_time);
+    // Draws a tick of the game, only from the snapshot so it can run on the render thread.
+    // When the frame follows the one on the screen, only the old tail, the old and new head and the apple
+    // are drawn, the border and the art are left alone, so a frame costs the same whatever the snake length
+    void update_game_window(const FrameSnapshot &frame);
+    // The next frame is drawn whole, for when something else drew over the game window
+    void invalidate();
     void close_window();
     void render_content();
     void wait_for_user_win_screen();
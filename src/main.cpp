@@ -4,26 +4,32 @@
 #include "graphics/graphics.hpp"
 #include <algorithm>
 #include <cstdint>
-
-Snake::LevelList *default_levels() {
-    Snake::LevelList* levels = new Snake::LevelList;
-
-    for (uint16_t i = 1; i <=8; i++) {
-        levels->add_element(Snake::LevelInfo(0, i, Snake::DIFFICULTY_EASY));
-        levels->add_element(Snake::LevelInfo(0, i, Snake::DIFFICULTY_NORMAL));
-        levels->add_element(Snake::LevelInfo(0, i, Snake::DIFFICULTY_HARD));
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char **argv) {
+    const char *replay_directory = nullptr;
+    bool autopilot = false;
+    bool input_stats = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--record-replays") == 0 && i + 1 < argc) {
+            replay_directory = argv[++i];
+        } else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            autopilot = true;
+        } else if (std::strcmp(argv[i], "--input-stats") == 0) {
+            input_stats = true;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--record-replays DIRECTORY] [--autopilot] [--input-stats]\n", argv[0]);
+            return 1;
+        }
     }
 
-    return levels;
-}
-
-int main(int, char **) {
     Graphics::start_ncurses();
 
     Snake::LevelList* level_list = Snake::LevelList::from_file(LEVELS_FILE_NAME);
 
     if(!level_list) {
-        level_list = default_levels();
+        level_list = Snake::LevelList::default_levels();
     }
 
     uint16_t window_width, window_height;
@@ -32,7 +38,16 @@ int main(int, char **) {
     window_width = std::max<uint16_t>(window_width, 20);
     window_height = std::max<uint16_t>(window_height, 10);
 
-    Snake::SnakeGameManager game_manager(window_width, window_height, level_list);
+    Snake::SnakeGameManager game_manager(window_width, window_height, level_list, replay_directory, autopilot);
 
     Graphics::stop_ncurses();
+
+    if (input_stats) {
+        Snake::InputLatency latency = game_manager.get_input_latency();
+        std::printf("%llu turns applied\n", (unsigned long long)latency.turn_count);
+        if (latency.turn_count > 0) {
+            std::printf("input latency: %.1f ms on average, %.1f ms at worst\n",
+                        latency.total_latency / 1e6 / latency.turn_count, latency.worst_latency / 1e6);
+        }
+    }
 }
@@ -0,0 +1,17 @@
+#ifndef CLOCK_CPP
+#define CLOCK_CPP
+
+#include "runtime/clock.hpp"
+#include <ctime>
+
+namespace Runtime {
+
+int64_t get_monotonic_time() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1'000'000'000 + now.tv_nsec;
+}
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <cstdint>
+
+namespace Runtime {
+
+// CLOCK_MONOTONIC in nanoseconds, the clock of every deadline of the project
+int64_t get_monotonic_time();
+
+} // namespace Runtime
+
+#endif
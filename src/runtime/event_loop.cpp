@@ -0,0 +1,196 @@
+#ifndef EVENT_LOOP_CPP
+#define EVENT_LOOP_CPP
+
+#include "runtime/event_loop.hpp"
+#include <cerrno>
+#include <exception>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace Runtime {
+
+#define EVENT_LOOP_MAX_EVENTS 256
+#define EVENT_LOOP_TIMER_RESOLUTION 1'000'000 // nanoseconds, deadlines of the same millisecond wake up together
+
+// epoll data of the loop's own descriptors, watched descriptors use their own number
+#define EVENT_LOOP_WAKE_DATA UINT64_MAX
+#define EVENT_LOOP_TIMER_DATA (UINT64_MAX - 1)
+
+// events that end any wait, a broken descriptor must not keep its task waiting forever
+static constexpr uint32_t ALWAYS_READY_EVENTS = EPOLLERR | EPOLLHUP;
+
+Task::promise_type::~promise_type() {
+    if (this->loop) {
+        this->loop->tasks.erase(std::coroutine_handle<promise_type>::from_promise(*this).address());
+    }
+}
+
+void Task::promise_type::unhandled_exception() {
+    // a task has no one to report to
+    std::terminate();
+}
+
+EventLoop::EventLoop() : timers(get_monotonic_time(), EVENT_LOOP_TIMER_RESOLUTION), stopping(false) {
+    this->armed_wakeup = 0;
+    this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    this->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    this->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (this->epoll_fd < 0 || this->wake_fd < 0 || this->timer_fd < 0) {
+        close(this->epoll_fd);
+        close(this->wake_fd);
+        close(this->timer_fd);
+        throw std::runtime_error("Could not create the descriptors of an event loop");
+    }
+
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = EVENT_LOOP_WAKE_DATA;
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->wake_fd, &event);
+    event.data.u64 = EVENT_LOOP_TIMER_DATA;
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->timer_fd, &event);
+}
+
+EventLoop::~EventLoop() {
+    this->destroy_tasks();
+    close(this->epoll_fd);
+    close(this->wake_fd);
+    close(this->timer_fd);
+}
+
+void EventLoop::spawn(Task task) {
+    std::coroutine_handle<Task::promise_type> handle = task.handle;
+    task.handle = nullptr;
+    handle.promise().loop = this;
+    this->tasks.insert(handle.address());
+    handle.resume();
+}
+
+void EventLoop::destroy_tasks() {
+    // destroying a frame runs the destructors of its locals, which unwatch and close their descriptors,
+    // and its promise removes it from the set
+    while (!this->tasks.empty()) {
+        std::coroutine_handle<>::from_address(*this->tasks.begin()).destroy();
+    }
+}
+
+void EventLoop::stop() {
+    this->stopping = true;
+    uint64_t one = 1;
+    ssize_t written = write(this->wake_fd, &one, sizeof(one));
+    (void)written;
+}
+
+void EventLoop::watch(int fd, bool exclusive) {
+    this->watchers[fd] = {0, 0, nullptr, nullptr};
+
+    struct epoll_event event = {};
+    event.events = exclusive ? EPOLLIN | EPOLLET | EPOLLEXCLUSIVE : EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.u64 = (uint64_t)fd;
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+void EventLoop::unwatch(int fd) {
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    this->watchers.erase(fd);
+}
+
+bool EventLoop::IoAwaiter::await_ready() {
+    Watcher &watcher = this->loop->watchers.at(this->fd);
+    uint32_t matching = watcher.pending_events & (this->events | ALWAYS_READY_EVENTS);
+    if (!matching) {
+        return false;
+    }
+    watcher.pending_events &= ~this->events;
+    this->ready_events = matching;
+    return true;
+}
+
+void EventLoop::wait_for_io(int fd, uint32_t events, std::coroutine_handle<> waiter, uint32_t *ready_events) {
+    Watcher &watcher = this->watchers.at(fd);
+    watcher.wanted_events = events | ALWAYS_READY_EVENTS;
+    watcher.waiter = waiter;
+    watcher.ready_events = ready_events;
+}
+
+void EventLoop::run() {
+    struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+    while (!this->stopping) {
+        this->arm_timer();
+        int event_count = epoll_wait(this->epoll_fd, events, EVENT_LOOP_MAX_EVENTS, -1);
+        if (event_count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // the tasks run after the whole batch is recorded, a task may unwatch any descriptor
+        bool timer_expired = false;
+        this->ready.clear();
+        for (int i = 0; i < event_count; i++) {
+            uint64_t data = events[i].data.u64;
+            if (data == EVENT_LOOP_WAKE_DATA) {
+                continue;
+            }
+            if (data == EVENT_LOOP_TIMER_DATA) {
+                uint64_t expirations;
+                ssize_t result = read(this->timer_fd, &expirations, sizeof(expirations));
+                (void)result;
+                timer_expired = true;
+                // the timer is disarmed now, even if the next wakeup happens to be the same time
+                this->armed_wakeup = 0;
+                continue;
+            }
+
+            std::unordered_map<int, Watcher>::iterator found = this->watchers.find((int)data);
+            if (found == this->watchers.end()) {
+                continue;
+            }
+            Watcher &watcher = found->second;
+            watcher.pending_events |= events[i].events;
+            uint32_t matching = watcher.pending_events & watcher.wanted_events;
+            if (watcher.waiter && matching) {
+                watcher.pending_events &= ~watcher.wanted_events | ALWAYS_READY_EVENTS;
+                *watcher.ready_events = matching;
+                this->ready.push_back(watcher.waiter);
+                watcher.waiter = nullptr;
+                watcher.wanted_events = 0;
+            }
+        }
+        for (std::coroutine_handle<> waiter : this->ready) {
+            waiter.resume();
+        }
+
+        if (timer_expired) {
+            this->due_timers.clear();
+            this->timers.advance(get_monotonic_time(), this->due_timers);
+            for (const TimerWheel::Timer &timer : this->due_timers) {
+                std::coroutine_handle<>::from_address((void *)(uintptr_t)timer.id).resume();
+            }
+        }
+    }
+}
+
+void EventLoop::arm_timer() {
+    int64_t wakeup = this->timers.get_next_wakeup();
+    if (wakeup == INT64_MAX) {
+        wakeup = 0;
+    }
+    if (wakeup == this->armed_wakeup) {
+        return;
+    }
+    this->armed_wakeup = wakeup;
+
+    // a zero it_value disarms the timer, a time in the past fires right away
+    struct itimerspec value = {};
+    value.it_value.tv_sec = wakeup / 1'000'000'000;
+    value.it_value.tv_nsec = wakeup % 1'000'000'000;
+    timerfd_settime(this->timer_fd, TFD_TIMER_ABSTIME, &value, NULL);
+}
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include "runtime/clock.hpp"
+#include "runtime/timer_wheel.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Runtime {
+
+class EventLoop;
+
+// A coroutine run by an EventLoop. It starts when it is spawned, and the loop destroys its frame
+// when it returns or when the loop is destroyed, so locals are the place for sockets and other resources
+class Task {
+  public:
+    struct promise_type {
+        EventLoop *loop = nullptr;
+
+        ~promise_type();
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception();
+    };
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {
+    }
+
+    friend class EventLoop;
+
+  public:
+    Task(Task &&other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    Task &operator=(Task &&) = delete;
+
+    // A task that was never spawned is destroyed with its frame
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+};
+
+// Single threaded event loop for coroutines: every wait of a task (a deadline, a socket ready to be read
+// or written) is a co_await that suspends it until epoll or the timer wheel wakes it up.
+// A waiting task costs its coroutine frame and nothing else, so one thread runs thousands of them
+class EventLoop {
+  private:
+    struct Watcher {
+        uint32_t pending_events;        // edges seen since the last wait on the descriptor
+        uint32_t wanted_events;         // events the waiting task wakes up for
+        std::coroutine_handle<> waiter; // nullptr if no task is waiting
+        uint32_t *ready_events;         // where the waiting task finds the events that woke it up
+    };
+
+    int epoll_fd;
+    int wake_fd;  // eventfd written by stop()
+    int timer_fd; // armed at the next wakeup of timers
+    int64_t armed_wakeup;
+    TimerWheel timers; // coroutine addresses by deadline
+    std::vector<TimerWheel::Timer> due_timers;
+    std::unordered_map<int, Watcher> watchers;
+    std::unordered_set<void *> tasks; // frames of the live tasks
+    std::vector<std::coroutine_handle<>> ready;
+    std::atomic<bool> stopping;
+
+    void arm_timer();
+    void wait_for_io(int fd, uint32_t events, std::coroutine_handle<> waiter, uint32_t *ready_events);
+
+    friend struct Task::promise_type;
+
+  public:
+    class SleepAwaiter {
+        EventLoop *loop;
+        int64_t deadline;
+
+      public:
+        SleepAwaiter(EventLoop *loop, int64_t deadline) : loop(loop), deadline(deadline) {
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> waiter) {
+            loop->timers.schedule((uint64_t)(uintptr_t)waiter.address(), deadline);
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    class IoAwaiter {
+        EventLoop *loop;
+        int fd;
+        uint32_t events;
+        uint32_t ready_events;
+
+      public:
+        IoAwaiter(EventLoop *loop, int fd, uint32_t events) : loop(loop), fd(fd), events(events), ready_events(0) {
+        }
+
+        bool await_ready();
+
+        void await_suspend(std::coroutine_handle<> waiter) {
+            loop->wait_for_io(fd, events, waiter, &ready_events);
+        }
+
+        // The epoll events that ended the wait, errors and hang ups end every wait
+        uint32_t await_resume() const noexcept {
+            return ready_events;
+        }
+    };
+
+    // Throws std::runtime_error if the descriptors of the loop cannot be created
+    EventLoop();
+    // Destroys the tasks that have not returned yet
+    ~EventLoop();
+
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    // Runs the task until its first wait, the loop owns it from now on
+    void spawn(Task task);
+
+    // Runs the tasks until stop() is called
+    void run();
+
+    // Destroys the tasks that have not returned yet, their locals release what they hold.
+    // Only once run() returned for good: the timers of sleeping tasks are not cancelled
+    void destroy_tasks();
+
+    // Makes run() return, can be called from any thread
+    void stop();
+
+    // Adds a non blocking descriptor to the loop, edge triggered.
+    // exclusive is for listening sockets shared by many loops: only one of them wakes up for a connection
+    void watch(int fd, bool exclusive = false);
+    // Must be called before closing a watched descriptor
+    void unwatch(int fd);
+
+    // co_await sleep_until(deadline) resumes the task once CLOCK_MONOTONIC reaches deadline, in nanoseconds
+    SleepAwaiter sleep_until(int64_t deadline) {
+        return SleepAwaiter(this, deadline);
+    }
+
+    // co_await wait_for(fd, events) resumes the task once the watched descriptor has one of the epoll events.
+    // Edges that came while the task was busy are kept, so nothing is lost between two waits
+    IoAwaiter wait_for(int fd, uint32_t events) {
+        return IoAwaiter(this, fd, events);
+    }
+
+    size_t get_task_count() const {
+        return tasks.size();
+    }
+};
+
+// Keeps a descriptor watched by a loop for the lifetime of a task local
+class WatchedFd {
+  private:
+    EventLoop *loop;
+    int fd;
+
+  public:
+    WatchedFd(EventLoop *loop, int fd, bool exclusive = false) : loop(loop), fd(fd) {
+        loop->watch(fd, exclusive);
+    }
+
+    ~WatchedFd() {
+        loop->unwatch(fd);
+    }
+
+    WatchedFd(const WatchedFd &) = delete;
+    WatchedFd &operator=(const WatchedFd &) = delete;
+};
+
+} // namespace Runtime
+
+#endif
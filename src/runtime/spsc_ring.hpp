@@ -0,0 +1,59 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace Runtime {
+
+// Bounded queue between exactly one producer thread and one consumer thread.
+// Both sides are wait-free: a push or a pop is a few loads and one release store, never a lock or a retry.
+// Each index is only written by its own side and lives on its own cache line, so they do not bounce
+template <typename T, size_t Capacity> class SpscRing {
+  private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head; // next slot to pop, written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail; // next slot to push, written by the producer
+    alignas(CACHE_LINE_SIZE) T slots[Capacity];
+
+  public:
+    SpscRing() : head(0), tail(0) {
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // Producer side, returns false if the ring is full
+    bool push(const T &value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[position & (Capacity - 1)] = value;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, returns false if the ring is empty
+    bool pop(T &value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[position & (Capacity - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, drops everything pushed so far
+    void clear() {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+};
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef TIMER_WHEEL_CPP
+#define TIMER_WHEEL_CPP
+
+#include "runtime/timer_wheel.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace Runtime {
+
+TimerWheel::TimerWheel(int64_t start_time, int64_t resolution) {
+    this->start_time = start_time;
+    this->resolution = std::max<int64_t>(resolution, 1);
+    this->current_tick = 0;
+    this->timer_count = 0;
+    std::fill(this->occupied, this->occupied + LEVELS, 0);
+}
+
+uint64_t TimerWheel::get_deadline_tick(int64_t deadline) const {
+    if (deadline <= this->start_time) {
+        return 0;
+    }
+    return (uint64_t)(deadline - this->start_time + this->resolution - 1) / this->resolution;
+}
+
+void TimerWheel::insert(const Timer &timer, uint64_t tick) {
+    // timers beyond the last turn of the top wheel wait at its end and are placed again from there
+    const uint64_t span = (uint64_t)1 << (SLOT_BITS * LEVELS);
+    if ((tick ^ this->current_tick) >= span) {
+        tick = this->current_tick | (span - 1);
+    }
+
+    // the lowest wheel whose current turn contains the tick
+    uint64_t difference = tick ^ this->current_tick;
+    uint32_t level = 0;
+    while (level + 1 < LEVELS && difference >> (SLOT_BITS * (level + 1))) {
+        level++;
+    }
+
+    uint32_t slot = (tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    this->slots[level][slot].push_back(timer);
+    this->occupied[level] |= (uint64_t)1 << slot;
+}
+
+void TimerWheel::cascade(uint32_t level, uint32_t slot) {
+    if (!(this->occupied[level] >> slot & 1)) {
+        return;
+    }
+    this->occupied[level] &= ~((uint64_t)1 << slot);
+    std::swap(this->moving, this->slots[level][slot]);
+    for (const Timer &timer : this->moving) {
+        this->insert(timer, this->get_deadline_tick(timer.deadline));
+    }
+    this->moving.clear();
+}
+
+void TimerWheel::schedule(uint64_t id, int64_t deadline) {
+    uint64_t tick = this->get_deadline_tick(deadline);
+    if (tick < this->current_tick) {
+        this->overdue.push_back({id, deadline});
+    } else {
+        this->insert({id, deadline}, tick);
+    }
+    this->timer_count++;
+}
+
+void TimerWheel::advance(int64_t now, std::vector<Timer> &due) {
+    if (now < this->start_time) {
+        return;
+    }
+    const uint64_t last_tick = (uint64_t)(now - this->start_time) / this->resolution;
+
+    due.insert(due.end(), this->overdue.begin(), this->overdue.end());
+    this->timer_count -= this->overdue.size();
+    this->overdue.clear();
+
+    // timers that waited at the end of the top wheel, placed again once the next turn has started
+    std::vector<Timer> parked;
+    while (this->current_tick <= last_tick) {
+        uint32_t slot = this->current_tick & (SLOTS - 1);
+        if (this->occupied[0] >> slot & 1) {
+            this->occupied[0] &= ~((uint64_t)1 << slot);
+            std::swap(this->moving, this->slots[0][slot]);
+            for (const Timer &timer : this->moving) {
+                uint64_t tick = this->get_deadline_tick(timer.deadline);
+                if (tick > this->current_tick) {
+                    parked.push_back(timer);
+                    continue;
+                }
+                due.push_back(timer);
+                this->timer_count--;
+            }
+            this->moving.clear();
+        }
+
+        // skip the empty slots up to the next timer or the next turn, whichever comes first
+        uint64_t later_slots = slot + 1 < SLOTS ? this->occupied[0] >> (slot + 1) << (slot + 1) : 0;
+        uint64_t next_tick = later_slots ? (this->current_tick & ~(uint64_t)(SLOTS - 1)) + __builtin_ctzll(later_slots)
+                                         : (this->current_tick | (SLOTS - 1)) + 1;
+        this->current_tick = std::min(next_tick, last_tick + 1);
+
+        // a new turn of a wheel brings down the timers of the current slot of the wheel above
+        for (uint32_t level = 1; level < LEVELS; level++) {
+            if (this->current_tick & (((uint64_t)1 << (SLOT_BITS * level)) - 1)) {
+                break;
+            }
+            this->cascade(level, (this->current_tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+        }
+        for (const Timer &timer : parked) {
+            this->insert(timer, this->get_deadline_tick(timer.deadline));
+        }
+        parked.clear();
+    }
+}
+
+int64_t TimerWheel::get_next_wakeup() const {
+    if (!this->timer_count) {
+        return INT64_MAX;
+    }
+    if (!this->overdue.empty()) {
+        // the last expired tick, advance returns them right away
+        return this->start_time + ((int64_t)this->current_tick - 1) * this->resolution;
+    }
+
+    for (uint32_t level = 0; level < LEVELS; level++) {
+        const uint32_t shift = SLOT_BITS * level;
+        uint32_t index = (this->current_tick >> shift) & (SLOTS - 1);
+        // the current slot of an upper wheel has already been brought down
+        uint32_t first = level == 0 ? index : index + 1;
+        uint64_t slots = first < SLOTS ? this->occupied[level] >> first << first : 0;
+        if (slots) {
+            uint64_t turn = this->current_tick >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+            uint64_t tick = turn | (uint64_t)__builtin_ctzll(slots) << shift;
+            return this->start_time + (int64_t)tick * this->resolution;
+        }
+    }
+    return INT64_MAX;
+}
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Runtime {
+
+// Hierarchical timer wheel: TIMER_WHEEL_LEVELS wheels of 64 slots, each slot of a wheel spans
+// a whole turn of the wheel below it. A timer goes in the lowest wheel whose turn still reaches its
+// deadline, so scheduling is O(1) whatever the number of timers, and timers only move down a wheel
+// when the wheel below starts the turn holding them. Timers due in the same tick come out as one batch.
+// There is no cancel: the owner of an id ignores the timers it does not expect anymore
+class TimerWheel {
+  public:
+    struct Timer {
+        uint64_t id;
+        int64_t deadline;
+    };
+
+  private:
+    static constexpr uint32_t LEVELS = 4;
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+
+    int64_t start_time;
+    int64_t resolution;
+    uint64_t current_tick; // next tick to expire, every earlier one is done
+    size_t timer_count;
+
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS]; // bit i is set if slots[level][i] is not empty
+    std::vector<Timer> moving;  // timers taken out of a slot, kept to reuse its memory
+    std::vector<Timer> overdue; // timers scheduled for a tick that has already expired
+
+    // Tick of a deadline, rounded up so a timer never expires early
+    uint64_t get_deadline_tick(int64_t deadline) const;
+
+    // Puts the timer in the slot of its tick, tick must not have expired yet
+    void insert(const Timer &timer, uint64_t tick);
+
+    // Moves the timers of a slot into the lower wheels
+    void cascade(uint32_t level, uint32_t slot);
+
+  public:
+    // Times are in any unit, e.g. nanoseconds, a tick lasts resolution of them
+    TimerWheel(int64_t start_time, int64_t resolution);
+
+    // Adds a timer expiring at deadline, rounded up to the next tick so it never expires early
+    void schedule(uint64_t id, int64_t deadline);
+
+    // Expires every timer whose tick has started by now, appending them to due in tick order
+    void advance(int64_t now, std::vector<Timer> &due);
+
+    // Returns a time at which advance should be called next, never after the earliest deadline,
+    // or INT64_MAX if there are no timers. It may be earlier when the next timer sits in an upper wheel
+    int64_t get_next_wakeup() const;
+
+    size_t size() const {
+        return timer_count;
+    }
+};
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace Runtime {
+
+// Hands the latest value from one writer thread to one reader thread without locks or copies.
+// The writer fills its back buffer and publishes it by swapping it with the middle one, the reader
+// swaps its front buffer with the middle one when something new is there. Neither side ever waits,
+// the reader only sees whole values, and values published faster than they are read are skipped
+template <typename T> class TripleBuffer {
+  private:
+    static constexpr uint8_t INDEX_MASK = 3;
+    static constexpr uint8_t FRESH = 4; // the middle buffer was published and not taken yet
+
+    T buffers[3];
+    std::atomic<uint8_t> middle;
+    uint8_t back;  // owned by the writer
+    uint8_t front; // owned by the reader
+
+  public:
+    TripleBuffer() : middle(1), back(0), front(2) {
+    }
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Writer side, the buffer to fill before publish(). It holds an older value, not necessarily the last one
+    T &get_back() {
+        return buffers[back];
+    }
+
+    // Writer side, makes the back buffer the latest value
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader side, returns false if nothing was published since the last call
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Reader side, the value taken by the last successful acquire()
+    const T &get_front() const {
+        return buffers[front];
+    }
+};
+
+} // namespace Runtime
+
+#endif
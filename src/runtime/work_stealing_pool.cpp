@@ -0,0 +1,116 @@
+#ifndef WORK_STEALING_POOL_CPP
+#define WORK_STEALING_POOL_CPP
+
+#include "runtime/work_stealing_pool.hpp"
+#include <algorithm>
+
+namespace Runtime {
+
+// index of the worker running on the current thread, -1 outside of the pool
+static thread_local int current_worker_index = -1;
+static thread_local const WorkStealingPool *current_pool = nullptr;
+
+WorkStealingPool::WorkStealingPool(uint32_t thread_count)
+    : queued_tasks(0), pending_tasks(0), stolen_tasks(0), next_worker(0), stopping(false) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        this->workers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+    for (uint32_t i = 0; i < thread_count; i++) {
+        this->threads.emplace_back(&WorkStealingPool::run_worker, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->state_mutex);
+        this->stopping = true;
+    }
+    this->work_available.notify_all();
+    for (std::thread &thread : this->threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    uint32_t worker_index;
+    if (current_pool == this) {
+        worker_index = current_worker_index;
+    } else {
+        worker_index = this->next_worker.fetch_add(1) % this->workers.size();
+    }
+
+    this->pending_tasks++;
+    {
+        std::lock_guard<std::mutex> lock(this->workers[worker_index]->mutex);
+        this->workers[worker_index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->state_mutex);
+        this->queued_tasks++;
+    }
+    this->work_available.notify_one();
+}
+
+bool WorkStealingPool::pop_task(uint32_t worker_index, Task &task) {
+    // newest own task first, it is the most likely to be still in cache
+    {
+        Worker &worker = *this->workers[worker_index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // otherwise steal the oldest task of another worker
+    for (size_t offset = 1; offset < this->workers.size(); offset++) {
+        Worker &victim = *this->workers[(worker_index + offset) % this->workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            this->stolen_tasks++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run_worker(uint32_t worker_index) {
+    current_worker_index = worker_index;
+    current_pool = this;
+
+    while (true) {
+        Task task;
+        if (this->pop_task(worker_index, task)) {
+            this->queued_tasks--;
+            task();
+
+            if (--this->pending_tasks == 0) {
+                std::lock_guard<std::mutex> lock(this->state_mutex);
+                this->all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->state_mutex);
+        this->work_available.wait(lock, [this] { return this->queued_tasks > 0 || this->stopping; });
+        if (this->stopping && this->queued_tasks == 0) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(this->state_mutex);
+    this->all_done.wait(lock, [this] { return this->pending_tasks == 0; });
+}
+
+} // namespace Runtime
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Runtime {
+
+// Thread pool where every worker owns a task queue.
+// Workers run their own tasks newest first and, once they run out of them,
+// steal the oldest tasks of the other workers, so uneven tasks keep every core busy
+class WorkStealingPool {
+  public:
+    typedef std::function<void()> Task;
+
+  private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    std::atomic<uint64_t> queued_tasks;  // tasks waiting inside of the queues
+    std::atomic<uint64_t> pending_tasks; // tasks submitted and not finished yet
+    std::atomic<uint64_t> stolen_tasks;
+    std::atomic<uint32_t> next_worker;   // round robin for tasks submitted from outside
+    bool stopping;
+
+    bool pop_task(uint32_t worker_index, Task &task);
+    void run_worker(uint32_t worker_index);
+
+  public:
+    // thread_count 0 means one thread per core
+    WorkStealingPool(uint32_t thread_count = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Adds a task, tasks submitted from a worker go to its own queue
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished
+    void wait_idle();
+
+    uint32_t get_thread_count() const {
+        return threads.size();
+    }
+
+    uint64_t get_stolen_task_count() const {
+        return stolen_tasks;
+    }
+};
+} // namespace Runtime
+
+#endif
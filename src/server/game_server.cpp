@@ -0,0 +1,142 @@
+#ifndef GAME_SERVER_CPP
+#define GAME_SERVER_CPP
+
+#include "server/game_server.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace Server {
+
+GameServer::GameServer(const ServerConfig &config) : config(config) {
+    this->tcp_port = 0;
+    if (config.tcp_port < 0 && !config.unix_path) {
+        throw std::invalid_argument("The server needs a TCP port or a Unix socket path");
+    }
+
+    try {
+        if (config.tcp_port >= 0) {
+            this->listen_tcp();
+        }
+        if (config.unix_path) {
+            this->listen_unix();
+        }
+
+        uint32_t reactor_count = config.reactor_count;
+        if (reactor_count == 0) {
+            reactor_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        Snake::RandomGenerator seed_generator(config.seed);
+        for (uint32_t i = 0; i < reactor_count; i++) {
+            this->reactors.push_back(new Reactor(config, this->listen_fds, seed_generator.next()));
+        }
+    } catch (...) {
+        for (Reactor *reactor : this->reactors) {
+            delete reactor;
+        }
+        this->close_listeners();
+        throw;
+    }
+}
+
+GameServer::~GameServer() {
+    this->stop();
+    for (Reactor *reactor : this->reactors) {
+        delete reactor;
+    }
+    this->close_listeners();
+}
+
+void GameServer::listen_tcp() {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create the TCP socket");
+    }
+    this->listen_fds.push_back(fd);
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(this->config.tcp_port);
+    if (inet_pton(AF_INET, this->config.tcp_address, &address.sin_addr) != 1) {
+        throw std::invalid_argument("The TCP address is not a valid IPv4 address");
+    }
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        throw std::runtime_error("Could not listen on the TCP port");
+    }
+
+    socklen_t address_size = sizeof(address);
+    getsockname(fd, (struct sockaddr *)&address, &address_size);
+    this->tcp_port = ntohs(address.sin_port);
+}
+
+void GameServer::listen_unix() {
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(this->config.unix_path) >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("The Unix socket path is too long");
+    }
+    std::strcpy(address.sun_path, this->config.unix_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create the Unix socket");
+    }
+    this->listen_fds.push_back(fd);
+
+    // a socket file left by a previous server would make bind fail
+    unlink(this->config.unix_path);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        throw std::runtime_error("Could not listen on the Unix socket");
+    }
+}
+
+void GameServer::close_listeners() {
+    for (int fd : this->listen_fds) {
+        close(fd);
+    }
+    this->listen_fds.clear();
+    if (this->config.unix_path) {
+        unlink(this->config.unix_path);
+    }
+}
+
+void GameServer::start() {
+    for (Reactor *reactor : this->reactors) {
+        reactor->start();
+    }
+}
+
+void GameServer::stop() {
+    for (Reactor *reactor : this->reactors) {
+        reactor->stop();
+    }
+}
+
+uint32_t GameServer::get_session_count() const {
+    uint32_t count = 0;
+    for (const Reactor *reactor : this->reactors) {
+        count += reactor->get_session_count();
+    }
+    return count;
+}
+
+uint64_t GameServer::get_tick_count() const {
+    uint64_t count = 0;
+    for (const Reactor *reactor : this->reactors) {
+        count += reactor->get_tick_count();
+    }
+    return count;
+}
+
+} // namespace Server
+
+#endif
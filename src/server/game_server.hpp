@@ -0,0 +1,53 @@
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include "server/reactor.hpp"
+#include "server/server_config.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Server {
+
+// Hosts Snake sessions for text terminals connecting over TCP or a Unix socket.
+// Every connection plays its own Game, the sessions are spread over one Reactor per core
+// and a player costs a socket, a game and a frame buffer instead of a process with its own ncurses
+class GameServer {
+  private:
+    ServerConfig config;
+    std::vector<int> listen_fds;
+    std::vector<Reactor *> reactors;
+    uint16_t tcp_port; // port actually bound, 0 without a TCP listener
+
+    void listen_tcp();
+    void listen_unix();
+    void close_listeners();
+
+  public:
+    // Opens the listening sockets, throws std::runtime_error if any of them cannot be opened
+    GameServer(const ServerConfig &config);
+    ~GameServer();
+
+    GameServer(const GameServer &) = delete;
+    GameServer &operator=(const GameServer &) = delete;
+
+    // Starts the reactor threads, sessions are accepted from now on
+    void start();
+
+    // Closes every session and stops the reactors
+    void stop();
+
+    uint16_t get_tcp_port() const {
+        return tcp_port;
+    }
+
+    uint32_t get_reactor_count() const {
+        return reactors.size();
+    }
+
+    uint32_t get_session_count() const;
+    uint64_t get_tick_count() const;
+};
+
+} // namespace Server
+
+#endif
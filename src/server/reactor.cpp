@@ -0,0 +1,134 @@
+#ifndef REACTOR_CPP
+#define REACTOR_CPP
+
+#include "server/reactor.hpp"
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+namespace Server {
+
+// Counts a session for get_session_count() as long as its task lives, even when the loop destroys it
+class CountedSession {
+  private:
+    std::atomic<uint32_t> &count;
+
+  public:
+    CountedSession(std::atomic<uint32_t> &count) : count(count) {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~CountedSession() {
+        count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    CountedSession(const CountedSession &) = delete;
+    CountedSession &operator=(const CountedSession &) = delete;
+};
+
+Reactor::Reactor(const ServerConfig &config, const std::vector<int> &listen_fds, uint64_t seed)
+    : config(config), listen_fds(listen_fds), seed_generator(seed), session_count(0), tick_count(0) {
+    this->next_session_id = 0;
+}
+
+Reactor::~Reactor() {
+    this->stop();
+}
+
+void Reactor::start() {
+    this->thread = std::thread(&Reactor::run, this);
+}
+
+void Reactor::stop() {
+    if (!this->thread.joinable()) {
+        return;
+    }
+    this->loop.stop();
+    this->thread.join();
+}
+
+void Reactor::run() {
+    for (int listen_fd : this->listen_fds) {
+        this->loop.spawn(this->accept_connections(listen_fd));
+    }
+    this->loop.run();
+    this->loop.destroy_tasks();
+}
+
+Runtime::Task Reactor::accept_connections(int listen_fd) {
+    // only one of the reactors waiting on a listening socket is woken up for a connection
+    Runtime::WatchedFd watched(&this->loop, listen_fd, true);
+    while (true) {
+        co_await this->loop.wait_for(listen_fd, EPOLLIN);
+
+        // edge triggered: accept until the backlog is empty
+        while (true) {
+            int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                // EAGAIN once the backlog is empty, or out of descriptors: the connection waits in the backlog
+                break;
+            }
+
+            // frames are small and should leave right away, this fails harmlessly on Unix sockets
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            this->loop.spawn(this->run_session(fd, this->next_session_id++, this->seed_generator.next()));
+        }
+    }
+}
+
+Runtime::Task Reactor::run_session(int fd, uint64_t id, uint64_t seed) {
+    CountedSession counted(this->session_count);
+    // declared before the watch, so the socket is unwatched before the session closes it
+    Session session(fd, id, this->config.difficulty, this->config.level, seed);
+    Runtime::WatchedFd watched(&this->loop, fd);
+
+    while (true) {
+        session.render(this->config.max_pending_output);
+        if (!session.write_output()) {
+            co_return;
+        }
+
+        // the next tick keeps the period of the game, unless the reactor fell a whole tick behind
+        int64_t frame_duration = session.get_frame_duration() * 1000ll;
+        int64_t deadline = Runtime::get_monotonic_time() + frame_duration;
+        while (session.is_playing()) {
+            co_await this->loop.sleep_until(deadline);
+
+            // what was typed since the last tick, the first direction wins like in the local game
+            if (!session.read_input()) {
+                co_return;
+            }
+            session.tick();
+            this->tick_count.fetch_add(1, std::memory_order_relaxed);
+            session.render(this->config.max_pending_output);
+            if (!session.write_output()) {
+                co_return;
+            }
+
+            int64_t now = Runtime::get_monotonic_time();
+            deadline += frame_duration;
+            if (deadline <= now) {
+                deadline = now + frame_duration;
+            }
+        }
+
+        // the end screen waits for Enter, and for the socket to take the rest of the last frame
+        while (!session.is_playing()) {
+            uint32_t events = EPOLLIN | EPOLLRDHUP;
+            if (session.has_pending_output()) {
+                events |= EPOLLOUT;
+            }
+            co_await this->loop.wait_for(fd, events);
+            if (!session.read_input() || !session.write_output()) {
+                co_return;
+            }
+        }
+    }
+}
+
+} // namespace Server
+
+#endif
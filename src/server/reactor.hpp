@@ -0,0 +1,60 @@
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include "game/random.hpp"
+#include "runtime/event_loop.hpp"
+#include "server/server_config.hpp"
+#include "server/session.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace Server {
+
+// An event loop on its own thread that owns a share of the sessions of the server.
+// Every session is a coroutine that reads like the game loop of a single player: it sleeps until its next tick,
+// then until Enter on the end screen, and each of those waits is a co_await on the loop.
+// A waiting session costs its coroutine frame and no system call at all, the ticks come from one timer wheel.
+// Every reactor waits on the same listening sockets, the kernel wakes one of them for each connection
+class Reactor {
+  private:
+    const ServerConfig config;
+    std::vector<int> listen_fds; // shared with the other reactors, not owned
+    Runtime::EventLoop loop;
+    uint64_t next_session_id;
+    Snake::RandomGenerator seed_generator;
+
+    std::atomic<uint32_t> session_count;
+    std::atomic<uint64_t> tick_count;
+    std::thread thread;
+
+    void run();
+    Runtime::Task accept_connections(int listen_fd);
+    Runtime::Task run_session(int fd, uint64_t id, uint64_t seed);
+
+  public:
+    // Throws std::runtime_error if the event loop cannot be created
+    Reactor(const ServerConfig &config, const std::vector<int> &listen_fds, uint64_t seed);
+    ~Reactor();
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    void start();
+
+    // Closes every session and joins the thread
+    void stop();
+
+    uint32_t get_session_count() const {
+        return session_count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_tick_count() const {
+        return tick_count.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace Server
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef SERVER_CONFIG_HPP
+#define SERVER_CONFIG_HPP
+
+#include "game/logic.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace Server {
+
+struct ServerConfig {
+    const char *tcp_address = "127.0.0.1";
+    int32_t tcp_port = -1;            // -1 for no TCP listener, 0 for any free port
+    const char *unix_path = nullptr;  // nullptr for no Unix socket listener
+    uint32_t reactor_count = 0;       // 0 means one reactor per core
+    Snake::GameDifficulty difficulty = Snake::DIFFICULTY_EASY;
+    uint32_t level = 1;               // level of the first game of every session
+    size_t max_pending_output = 1 << 16; // frames are skipped while a player has this many bytes not read yet
+    uint64_t seed = 0;                // seeds every game played on the server
+};
+
+} // namespace Server
+
+#endif
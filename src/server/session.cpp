@@ -0,0 +1,197 @@
+#ifndef SESSION_CPP
+#define SESSION_CPP
+
+#include "server/session.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Server {
+
+Session::Session(int fd, uint64_t id, Snake::GameDifficulty difficulty, uint32_t level, uint64_t seed)
+    : seed_generator(seed),
+      // a status line above the table and a help line below it
+      frame(Snake::get_playable_dimensions(difficulty).width, Snake::get_playable_dimensions(difficulty).height + 2) {
+    this->fd = fd;
+    this->id = id;
+    this->difficulty = difficulty;
+    this->level = level;
+    this->game = nullptr;
+    this->output_offset = 0;
+    this->start_game();
+}
+
+Session::~Session() {
+    append_terminal_reset(this->output, this->frame.get_height());
+    this->write_output();
+    delete this->game;
+    close(this->fd);
+}
+
+void Session::start_game() {
+    delete this->game;
+    this->game = new Snake::Game(0, 0, this->difficulty, this->level, this->seed_generator.next());
+    this->state = SESSION_PLAYING;
+    this->remaining_ticks = Snake::get_game_duration_ticks(this->difficulty, this->level);
+    this->pending_input = Snake::DIRECTION_NONE;
+}
+
+bool Session::receive(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        Snake::TerminalKey key = this->input.feed(data[i]);
+        switch (key) {
+            case Snake::TERMINAL_KEY_NONE:
+                break;
+            case Snake::TERMINAL_KEY_QUIT:
+                return false;
+            case Snake::TERMINAL_KEY_ENTER:
+                if (this->state == SESSION_WON && this->level < SESSION_LAST_LEVEL) {
+                    this->level++;
+                }
+                if (this->state != SESSION_PLAYING) {
+                    this->start_game();
+                }
+                break;
+            default:
+                // the first key of a tick wins, the others are dropped
+                if (this->state == SESSION_PLAYING && this->pending_input == Snake::DIRECTION_NONE) {
+                    this->pending_input = Snake::to_direction(key);
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+void Session::tick() {
+    if (this->state != SESSION_PLAYING) {
+        return;
+    }
+
+    Snake::Direction player_input = this->pending_input;
+    this->pending_input = Snake::DIRECTION_NONE;
+
+    // same order as SnakeGameManager::start_game: the time runs out before the next input is applied
+    if (this->remaining_ticks == 0) {
+        this->game->win_game();
+        this->state = SESSION_WON;
+        return;
+    }
+    this->remaining_ticks--;
+
+    switch (this->game->update_game(player_input)) {
+        case Snake::GAME_WON:
+            this->state = SESSION_WON;
+            break;
+        case Snake::GAME_LOST:
+            this->state = SESSION_LOST;
+            break;
+        default:
+            break;
+    }
+}
+
+void Session::draw_frame() {
+    Snake::GameTable playable_area = this->game->get_playable_area();
+    const uint16_t bottom = playable_area.height;
+    const uint16_t right = playable_area.width - 1;
+    char text[64];
+
+    this->frame.clear();
+
+    std::snprintf(text, sizeof(text), "Score: %5u", this->game->get_score());
+    this->frame.put_text(1, 0, text, FRAME_YELLOW);
+    std::snprintf(text, sizeof(text), "Level %u", this->level);
+    this->frame.put_centered_text(0, text, FRAME_YELLOW);
+    uint64_t remaining_seconds = (uint64_t)this->remaining_ticks * this->get_frame_duration() / 1'000'000;
+    std::snprintf(text, sizeof(text), "Time: %3u", (uint32_t)remaining_seconds);
+    this->frame.put_text(this->frame.get_width() - 11, 0, text, FRAME_YELLOW);
+
+    // the table is drawn one line below the status
+    for (uint16_t x = 0; x <= right; x++) {
+        this->frame.put(x, 1, x == 0 || x == right ? '+' : '-', FRAME_BLUE);
+        this->frame.put(x, bottom, x == 0 || x == right ? '+' : '-', FRAME_BLUE);
+    }
+    for (uint16_t y = 2; y < bottom; y++) {
+        this->frame.put(0, y, '|', FRAME_BLUE);
+        this->frame.put(right, y, '|', FRAME_BLUE);
+    }
+
+    switch (this->state) {
+        case SESSION_PLAYING: {
+            Snake::Coordinates apple_position = this->game->get_apple_position();
+            this->frame.put(apple_position.x, apple_position.y + 1, 'o', FRAME_RED);
+
+            const Snake::SnakeBody *snake_body = this->game->get_snake_body();
+            char part = '@';
+            for (Snake::SnakeBody::Iterator body_part = snake_body->begin(); body_part != snake_body->end();
+                 ++body_part) {
+                Snake::Coordinates coord = *body_part;
+                this->frame.put(coord.x, coord.y + 1, part, FRAME_GREEN);
+                part = '#';
+            }
+            this->frame.put_centered_text(bottom + 1, "Press Q to quit");
+            break;
+        }
+        case SESSION_WON:
+            this->frame.put_centered_text(bottom / 2, "GAME WON!!", FRAME_GREEN);
+            this->frame.put_centered_text(bottom / 2 + 2,
+                                          this->level < SESSION_LAST_LEVEL ? "PRESS ENTER TO START THE NEXT LEVEL"
+                                                                           : "PRESS ENTER TO PLAY AGAIN",
+                                          FRAME_YELLOW);
+            this->frame.put_centered_text(bottom + 1, "Press Q to quit");
+            break;
+        case SESSION_LOST:
+            this->frame.put_centered_text(bottom / 2, "GAME LOST", FRAME_RED);
+            this->frame.put_centered_text(bottom / 2 + 2, "PRESS ENTER TO PLAY AGAIN", FRAME_YELLOW);
+            this->frame.put_centered_text(bottom + 1, "Press Q to quit");
+            break;
+    }
+}
+
+void Session::render(size_t max_pending) {
+    if (this->output.size() - this->output_offset > max_pending) {
+        // the terminal still shows the last flushed frame, so nothing is lost by skipping this one
+        return;
+    }
+    this->draw_frame();
+    this->frame.flush(this->output);
+}
+
+bool Session::read_input() {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t received = recv(this->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (received == 0 || !this->receive(buffer, received)) {
+            return false;
+        }
+    }
+}
+
+bool Session::write_output() {
+    while (this->output_offset < this->output.size()) {
+        ssize_t written = send(this->fd, this->output.data() + this->output_offset,
+                               this->output.size() - this->output_offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        this->output_offset += written;
+    }
+    this->output.clear();
+    this->output_offset = 0;
+    return true;
+}
+
+} // namespace Server
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include "game/game.hpp"
+#include "game/logic.hpp"
+#include "game/terminal_input.hpp"
+#include "server/terminal_frame.hpp"
+#include <cstdint>
+#include <string>
+
+namespace Server {
+
+// the levels of LevelList::default_levels
+#define SESSION_LAST_LEVEL 8
+
+typedef enum : uint8_t {
+    SESSION_PLAYING,
+    SESSION_WON,  // waiting for Enter to play the next level
+    SESSION_LOST, // waiting for Enter to play the level again
+} SessionState;
+
+// One player connected to the server: a socket, the game it plays and the frames it has not received yet.
+// The task of the reactor playing the session reads its socket, calls tick() every frame duration
+// and writes the output
+class Session {
+  private:
+    int fd;
+    uint64_t id;
+    Snake::GameDifficulty difficulty;
+    uint32_t level;
+    Snake::RandomGenerator seed_generator; // seeds every game of the session
+    Snake::Game *game;
+    SessionState state;
+    uint32_t remaining_ticks;
+    Snake::Direction pending_input; // first direction typed since the last tick, like get_player_input
+
+    Snake::TerminalInput input;
+    TerminalFrame frame;
+    std::string output; // bytes not written to the socket yet, from output_offset on
+    size_t output_offset;
+
+    void start_game();
+    void draw_frame();
+
+    // Handles bytes typed by the player, returns false if the player quit
+    bool receive(const uint8_t *data, size_t size);
+
+  public:
+    // Takes ownership of the connected non blocking socket fd and starts a game of the given level
+    Session(int fd, uint64_t id, Snake::GameDifficulty difficulty, uint32_t level, uint64_t seed);
+    // Leaves the terminal usable, then closes the socket
+    ~Session();
+
+    Session(const Session &) = delete;
+    Session &operator=(const Session &) = delete;
+
+    // Reads and handles everything the player typed so far,
+    // returns false if the player quit or the connection is closed
+    bool read_input();
+
+    // Advances the game by one tick and queues the new frame
+    void tick();
+
+    // Queues the changes of the frame since the last render, unless the player is not reading
+    // and more than max_pending bytes are already waiting: the next render then sends the whole change
+    void render(size_t max_pending);
+
+    // Writes as much queued output as the socket takes,
+    // returns false if the connection is broken
+    bool write_output();
+
+    bool has_pending_output() const {
+        return output_offset < output.size();
+    }
+
+    bool is_playing() const {
+        return state == SESSION_PLAYING;
+    }
+
+    // Time between two ticks of the current game, in microseconds
+    uint32_t get_frame_duration() const {
+        return Snake::get_frame_duration(difficulty, level);
+    }
+
+    int get_fd() const {
+        return fd;
+    }
+
+    uint64_t get_id() const {
+        return id;
+    }
+
+    const Snake::Game *get_game() const {
+        return game;
+    }
+};
+
+} // namespace Server
+
+#endif
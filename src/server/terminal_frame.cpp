@@ -0,0 +1,106 @@
+#ifndef TERMINAL_FRAME_CPP
+#define TERMINAL_FRAME_CPP
+
+#include "server/terminal_frame.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Server {
+
+static uint16_t make_cell(char character, FrameColor color) {
+    return (uint8_t)character | (uint16_t)color << 8;
+}
+
+// Select Graphic Rendition for a color, bold like the ncurses UI draws the apple and the score
+static const char *get_color_sequence(uint8_t color) {
+    switch (color) {
+        case FRAME_RED:
+            return "\x1b[0;1;31m";
+        case FRAME_GREEN:
+            return "\x1b[0;32m";
+        case FRAME_BLUE:
+            return "\x1b[0;34m";
+        case FRAME_YELLOW:
+            return "\x1b[0;1;33m";
+        default:
+            return "\x1b[0m";
+    }
+}
+
+static void append_cursor_move(std::string &output, uint16_t x, uint16_t y) {
+    char sequence[32];
+    int length = std::snprintf(sequence, sizeof(sequence), "\x1b[%u;%uH", y + 1u, x + 1u);
+    output.append(sequence, length);
+}
+
+TerminalFrame::TerminalFrame(uint16_t width, uint16_t height) {
+    this->width = width;
+    this->height = height;
+    this->cells.assign((size_t)width * height, make_cell(' ', FRAME_DEFAULT));
+    this->flushed_cells = this->cells;
+    this->needs_full_redraw = true;
+}
+
+void TerminalFrame::clear() {
+    std::fill(this->cells.begin(), this->cells.end(), make_cell(' ', FRAME_DEFAULT));
+}
+
+void TerminalFrame::put(uint16_t x, uint16_t y, char character, FrameColor color) {
+    if (x < this->width && y < this->height) {
+        this->cells[(size_t)y * this->width + x] = make_cell(character, color);
+    }
+}
+
+void TerminalFrame::put_text(uint16_t x, uint16_t y, const char *text, FrameColor color) {
+    for (; *text; text++, x++) {
+        this->put(x, y, *text, color);
+    }
+}
+
+void TerminalFrame::put_centered_text(uint16_t y, const char *text, FrameColor color) {
+    size_t length = std::strlen(text);
+    uint16_t x = length < this->width ? (this->width - length) / 2 : 0;
+    this->put_text(x, y, text, color);
+}
+
+void TerminalFrame::flush(std::string &output) {
+    if (this->needs_full_redraw) {
+        // hide the cursor and clear the screen, then every cell is different from a blank one
+        output.append("\x1b[?25l\x1b[0m\x1b[H\x1b[2J");
+        std::fill(this->flushed_cells.begin(), this->flushed_cells.end(), make_cell(' ', FRAME_DEFAULT));
+        this->needs_full_redraw = false;
+    }
+
+    // the cursor and the color are only sent when they are not already right
+    uint32_t cursor = UINT32_MAX;
+    uint8_t color = UINT8_MAX;
+    for (uint32_t i = 0; i < this->cells.size(); i++) {
+        uint16_t cell = this->cells[i];
+        if (cell == this->flushed_cells[i]) {
+            continue;
+        }
+        this->flushed_cells[i] = cell;
+
+        if (cursor != i) {
+            append_cursor_move(output, i % this->width, i / this->width);
+        }
+        if (color != cell >> 8) {
+            color = cell >> 8;
+            output.append(get_color_sequence(color));
+        }
+        output.push_back((char)(cell & 0xff));
+        // the terminal cursor stays on the last column after writing it
+        cursor = (i + 1) % this->width ? i + 1 : UINT32_MAX;
+    }
+}
+
+void append_terminal_reset(std::string &output, uint16_t frame_height) {
+    output.append("\x1b[0m\x1b[?25h");
+    append_cursor_move(output, 0, frame_height);
+    output.append("\r\n");
+}
+
+} // namespace Server
+
+#endif
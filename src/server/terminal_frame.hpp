@@ -0,0 +1,63 @@
+#ifndef TERMINAL_FRAME_HPP
+#define TERMINAL_FRAME_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Server {
+
+// Same colors as Graphics::UIColors
+typedef enum : uint8_t {
+    FRAME_DEFAULT = 0,
+    FRAME_RED = 1,
+    FRAME_GREEN = 2,
+    FRAME_BLUE = 3,
+    FRAME_YELLOW = 4,
+} FrameColor;
+
+// A width x height grid of colored characters drawn for a remote terminal.
+// flush() writes the ANSI escape sequences that turn the last flushed frame into this one,
+// so once the first frame is out a tick of the game costs a few cells instead of the whole screen
+class TerminalFrame {
+  private:
+    uint16_t width;
+    uint16_t height;
+    std::vector<uint16_t> cells;         // character | color << 8
+    std::vector<uint16_t> flushed_cells; // cells as the terminal shows them
+    bool needs_full_redraw;
+
+  public:
+    TerminalFrame(uint16_t width, uint16_t height);
+
+    uint16_t get_width() const {
+        return width;
+    }
+
+    uint16_t get_height() const {
+        return height;
+    }
+
+    // Fills the frame with spaces
+    void clear();
+
+    // Cells outside of the frame are ignored
+    void put(uint16_t x, uint16_t y, char character, FrameColor color = FRAME_DEFAULT);
+    void put_text(uint16_t x, uint16_t y, const char *text, FrameColor color = FRAME_DEFAULT);
+    void put_centered_text(uint16_t y, const char *text, FrameColor color = FRAME_DEFAULT);
+
+    // The next flush clears the screen and draws every cell
+    void invalidate() {
+        needs_full_redraw = true;
+    }
+
+    // Appends to output what the terminal needs to show this frame
+    void flush(std::string &output);
+};
+
+// Sequences written when a terminal stops showing frames: default colors, visible cursor, cursor below the frame
+void append_terminal_reset(std::string &output, uint16_t frame_height);
+
+} // namespace Server
+
+#endif
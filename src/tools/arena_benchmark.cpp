@@ -0,0 +1,155 @@
+#include "game/arena.hpp"
+#include "game/logic.hpp"
+#include "game/random.hpp"
+#include "runtime/work_stealing_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Plays arenas with more and more snakes and reports the cost of a tick for each snake,
+// which should stay about the same whatever the number of snakes.
+// Then plays the most crowded arena again with 1 to THREADS threads and reports the speedup,
+// checking that every thread count ends with the same arena.
+// Usage: snake_arena_benchmark [SIDE] [TICKS] [THREADS]
+
+// Moves the strips of the arena on the work stealing pool, one strip for every thread
+class PoolStripExecutor : public Snake::StripExecutor {
+  private:
+    Runtime::WorkStealingPool *pool;
+
+  public:
+    PoolStripExecutor(Runtime::WorkStealingPool *pool) {
+        this->pool = pool;
+    }
+
+    uint32_t get_strip_count() const override {
+        return pool->get_thread_count();
+    }
+
+    void run(uint32_t task_count, const std::function<void(uint32_t)> &task) override {
+        for (uint32_t i = 0; i < task_count; i++) {
+            pool->submit([&task, i]() { task(i); });
+        }
+        pool->wait_idle();
+    }
+};
+
+// Cheap input policy: keep going, sometimes turn at random, and turn away from anything in front of the head
+static void choose_inputs(const Snake::Arena &arena, Snake::RandomGenerator &random_generator,
+                          std::vector<Snake::Direction> &inputs) {
+    const Snake::Direction directions[] = {Snake::DIRECTION_UP, Snake::DIRECTION_DOWN, Snake::DIRECTION_LEFT,
+                                           Snake::DIRECTION_RIGHT};
+    Snake::GameTable playable_area = arena.get_playable_area();
+    for (uint32_t snake = 0; snake < arena.get_snake_count(); snake++) {
+        inputs[snake] = Snake::DIRECTION_NONE;
+        if (!arena.is_alive(snake)) {
+            continue;
+        }
+
+        Snake::Coordinates head = arena.get_snake_head(snake);
+        uint32_t first = random_generator.next_bounded(4);
+        bool turn = random_generator.next_bounded(16) == 0;
+        for (uint32_t i = 0; i < 4; i++) {
+            Snake::Direction direction = turn ? directions[(first + i) % 4] : arena.get_current_direction(snake);
+            turn = true;
+            if (direction == ~arena.get_current_direction(snake)) {
+                continue;
+            }
+            Snake::Coordinates cell = head;
+            cell.x += (direction == Snake::DIRECTION_RIGHT) - (direction == Snake::DIRECTION_LEFT);
+            cell.y += (direction == Snake::DIRECTION_DOWN) - (direction == Snake::DIRECTION_UP);
+            if (cell.x > 0 && cell.y > 0 && cell.x < playable_area.width - 1 && cell.y < playable_area.height - 1 &&
+                arena.get_owner(cell) == Snake::Arena::NO_SNAKE) {
+                inputs[snake] = direction;
+                break;
+            }
+        }
+    }
+}
+
+struct ArenaRun {
+    double seconds; // time spent inside of Arena::step
+    uint64_t snake_ticks;
+    uint64_t total_score;
+    uint64_t hash; // of the final arena, equal runs have equal hashes
+};
+
+static ArenaRun play_arena(Snake::GameTable playable_area, uint32_t snake_count, uint32_t snake_length,
+                           uint32_t max_ticks, Snake::StripExecutor *executor) {
+    Snake::Arena arena(playable_area, snake_count, snake_length, snake_count, snake_count);
+    Snake::RandomGenerator random_generator(snake_count);
+    std::vector<Snake::Direction> inputs(snake_count);
+
+    // only the arena ticks are timed, not the inputs
+    ArenaRun run = {0, 0, 0, 1469598103934665603ull};
+    for (uint32_t tick = 0; tick < max_ticks; tick++) {
+        choose_inputs(arena, random_generator, inputs);
+        run.snake_ticks += arena.get_alive_count();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        arena.step(inputs.data(), executor);
+        run.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // FNV-1a over the heads, the scores and the apples
+    auto mix = [&run](uint64_t value) { run.hash = (run.hash ^ value) * 1099511628211ull; };
+    for (uint32_t snake = 0; snake < snake_count; snake++) {
+        run.total_score += arena.get_score(snake);
+        mix(arena.get_score(snake));
+        if (arena.is_alive(snake)) {
+            Snake::Coordinates head = arena.get_snake_head(snake);
+            mix((uint64_t)snake << 32 | (uint32_t)head.y << 16 | head.x);
+        }
+    }
+    for (uint32_t apple = 0; apple < arena.get_apple_count(); apple++) {
+        Snake::Coordinates position = arena.get_apple_position(apple);
+        mix((uint32_t)position.y << 16 | position.x);
+    }
+    return run;
+}
+
+int main(int argc, char **argv) {
+    uint32_t side = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2048;
+    uint32_t max_ticks = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 200;
+    uint32_t max_threads = argc > 3 ? std::strtoul(argv[3], NULL, 10) : std::thread::hardware_concurrency();
+    if (side < 16 || side > UINT16_MAX - 2) {
+        std::fprintf(stderr, "Usage: %s [SIDE] [TICKS] [THREADS], SIDE between 16 and %u\n", argv[0],
+                     UINT16_MAX - 2);
+        return 1;
+    }
+
+    // the playable area includes the borders
+    Snake::GameTable playable_area = {(uint16_t)(side + 2), (uint16_t)(side + 2)};
+    const uint32_t snake_length = 8;
+    uint64_t max_snakes = (uint64_t)(side + 1) / (snake_length + 1) * ((side + 1) / 2);
+
+    uint64_t snake_count = 64;
+    for (; snake_count <= max_snakes; snake_count *= 8) {
+        ArenaRun run = play_arena(playable_area, snake_count, snake_length, max_ticks, NULL);
+        std::printf("%7llu snakes: %8.1f us/tick, %5.1f ns/snake tick, %llu points\n",
+                    (unsigned long long)snake_count, run.seconds * 1e6 / max_ticks,
+                    run.seconds * 1e9 / run.snake_ticks, (unsigned long long)run.total_score);
+    }
+    snake_count /= 8;
+
+    // the single threaded tick is the reference for the speedup and for the final arena
+    ArenaRun reference = play_arena(playable_area, snake_count, snake_length, max_ticks, NULL);
+    std::printf("%7llu snakes, single threaded: %8.1f us/tick\n", (unsigned long long)snake_count,
+                reference.seconds * 1e6 / max_ticks);
+    bool identical = true;
+    for (uint32_t thread_count = 1; thread_count <= std::max(max_threads, 1u); thread_count++) {
+        Runtime::WorkStealingPool pool(thread_count);
+        PoolStripExecutor executor(&pool);
+        ArenaRun run = play_arena(playable_area, snake_count, snake_length, max_ticks, &executor);
+        bool same = run.hash == reference.hash && run.total_score == reference.total_score;
+        identical = identical && same;
+        std::printf("%7u threads: %8.1f us/tick, speedup %5.2fx, %s\n", thread_count,
+                    run.seconds * 1e6 / max_ticks, reference.seconds / run.seconds,
+                    same ? "same arena" : "DIFFERENT ARENA");
+    }
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "game/game.hpp"
+#include "game/game_batch.hpp"
+#include "game/logic.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Plays the same games with one Game object each and with a single GameBatch,
+// checks that both give the same results and compares their speed.
+// Usage: snake_batch_benchmark [GAMES] [TICKS]
+
+// GameBatch is meant to play an order of magnitude more ticks per second than Game
+static const double TARGET_SPEEDUP = 10.0;
+
+// Cheap input policy shared by both runs: go towards the apple
+static Snake::Direction towards_apple(Snake::Coordinates head, Snake::Coordinates apple) {
+    if (head.x < apple.x) {
+        return Snake::DIRECTION_RIGHT;
+    } else if (head.x > apple.x) {
+        return Snake::DIRECTION_LEFT;
+    } else if (head.y < apple.y) {
+        return Snake::DIRECTION_DOWN;
+    }
+    return Snake::DIRECTION_UP;
+}
+
+int main(int argc, char **argv) {
+    uint32_t game_count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4096;
+    uint32_t max_ticks = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 1000;
+    const uint32_t level = 1;
+
+    bool all_equal = true;
+    Snake::GameDifficulty difficulties[] = {Snake::DIFFICULTY_EASY, Snake::DIFFICULTY_NORMAL, Snake::DIFFICULTY_HARD};
+    for (Snake::GameDifficulty difficulty : difficulties) {
+        std::vector<uint64_t> seeds(game_count);
+        for (uint32_t i = 0; i < game_count; i++) {
+            seeds[i] = i * 0x9E3779B97F4A7C15 + difficulty;
+        }
+        std::vector<Snake::Direction> inputs(game_count);
+
+        // one object per game
+        std::vector<Snake::Game *> games(game_count);
+        for (uint32_t i = 0; i < game_count; i++) {
+            games[i] = new Snake::Game(0, 0, difficulty, level, seeds[i]);
+        }
+        uint64_t game_ticks = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t tick = 0; tick < max_ticks; tick++) {
+            for (Snake::Game *game : games) {
+                if (game->get_game_result() == Snake::GAME_UNFINISHED) {
+                    game->update_game(towards_apple(game->get_snake_body()->get_head(), game->get_apple_position()));
+                    game_ticks++;
+                }
+            }
+        }
+        double single_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // the whole batch at once
+        Snake::GameBatch batch(difficulty, level, seeds.data(), game_count);
+        uint64_t batch_ticks = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t tick = 0; tick < max_ticks; tick++) {
+            for (uint32_t i = 0; i < game_count; i++) {
+                inputs[i] = towards_apple(batch.get_snake_head(i), batch.get_apple_position(i));
+            }
+            batch_ticks += batch.get_unfinished_count();
+            batch.step(inputs.data());
+        }
+        double batch_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        uint32_t mismatches = 0;
+        for (uint32_t i = 0; i < game_count; i++) {
+            Snake::Coordinates head = games[i]->get_snake_body()->get_head();
+            if (games[i]->get_score() != batch.get_score(i) || games[i]->get_tick_count() != batch.get_tick_count(i) ||
+                games[i]->get_game_result() != batch.get_game_result(i) || head.x != batch.get_snake_head(i).x ||
+                head.y != batch.get_snake_head(i).y) {
+                mismatches++;
+            }
+            delete games[i];
+        }
+        all_equal = all_equal && mismatches == 0 && game_ticks == batch_ticks;
+
+        double speedup = single_seconds / batch_seconds;
+        std::printf("difficulty %d: %llu game ticks, Game %.2f M ticks/s, GameBatch %.2f M ticks/s (%.1fx, target "
+                    "%.0fx, %.1fx short), %u mismatches\n",
+                    difficulty, (unsigned long long)game_ticks, game_ticks / single_seconds / 1e6,
+                    batch_ticks / batch_seconds / 1e6, speedup, TARGET_SPEEDUP, TARGET_SPEEDUP / speedup, mismatches);
+    }
+
+    return all_equal ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#include "game/game.hpp"
+#include "game/logic.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+
+// Plays large board games with longer and longer snakes and reports the time of a tick,
+// which should stay the same whatever the length of the snake, and the memory of the game.
+// Usage: snake_huge_benchmark [SIDE] [TICKS]
+
+// Goes towards the apple when it is safe, otherwise takes any safe direction
+static Snake::Direction safe_towards_apple(const Snake::Game *game) {
+    const Snake::Direction directions[] = {Snake::DIRECTION_UP, Snake::DIRECTION_DOWN, Snake::DIRECTION_LEFT,
+                                           Snake::DIRECTION_RIGHT};
+    Snake::Coordinates head = game->get_snake_body()->get_head();
+    Snake::Coordinates apple = game->get_apple_position();
+    Snake::Coordinates tail = game->get_snake_body()->get_tail();
+    Snake::GameTable playable_area = game->get_playable_area();
+
+    Snake::Direction fallback = Snake::DIRECTION_NONE;
+    for (Snake::Direction direction : directions) {
+        if (direction == ~game->get_current_direction()) {
+            continue;
+        }
+        Snake::Coordinates cell = head;
+        cell.x += (direction == Snake::DIRECTION_RIGHT) - (direction == Snake::DIRECTION_LEFT);
+        cell.y += (direction == Snake::DIRECTION_DOWN) - (direction == Snake::DIRECTION_UP);
+        bool inside = cell.x > 0 && cell.y > 0 && cell.x < playable_area.width - 1 && cell.y < playable_area.height - 1;
+        if (!inside || (game->is_cell_occupied(cell) && !Snake::coordinates_are_equal(cell, tail))) {
+            continue;
+        }
+
+        bool closer = (direction == Snake::DIRECTION_RIGHT && apple.x > head.x) ||
+                      (direction == Snake::DIRECTION_LEFT && apple.x < head.x) ||
+                      (direction == Snake::DIRECTION_DOWN && apple.y > head.y) ||
+                      (direction == Snake::DIRECTION_UP && apple.y < head.y);
+        if (closer) {
+            return direction;
+        }
+        fallback = direction;
+    }
+    return fallback;
+}
+
+int main(int argc, char **argv) {
+    uint32_t side = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4096;
+    uint32_t max_ticks = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 1000000;
+    if (side < 4 || side > UINT16_MAX) {
+        std::fprintf(stderr, "Usage: %s [SIDE] [TICKS], SIDE between 4 and %u\n", argv[0], UINT16_MAX);
+        return 1;
+    }
+
+    // the playable area includes the borders
+    Snake::GameTable playable_area = {(uint16_t)(side + 2), (uint16_t)(side + 2)};
+    uint64_t cell_count = (uint64_t)side * side;
+    std::printf("%ux%u cells, occupancy bitmap %.1f MB\n", side, side, cell_count / 8.0 / (1 << 20));
+
+    for (uint64_t length = 16; length < cell_count; length *= 8) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Snake::Game game(playable_area, Snake::DIFFICULTY_EASY, 1, length, length);
+        double setup_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        while (game.get_game_result() == Snake::GAME_UNFINISHED && game.get_tick_count() < max_ticks) {
+            game.update_game(safe_towards_apple(&game));
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // the body and the bitmap are the only structures that grow with the game
+        double game_megabytes = (length * sizeof(Snake::Coordinates) + cell_count / 8.0) / (1 << 20);
+        std::printf("length %9llu: setup %7.1f ms, %8u ticks, %6.1f ns/tick, %u points, game %.1f MB\n",
+                    (unsigned long long)length, setup_seconds * 1e3, game.get_tick_count(),
+                    seconds * 1e9 / game.get_tick_count(), game.get_score(), game_megabytes);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("peak resident memory %.1f MB\n", usage.ru_maxrss / 1024.0);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include "bots/mcts.hpp"
+#include "game/game.hpp"
+#include "game/logic.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Plays one game with the tree search bot in real time and reports how many playouts it runs per second.
+// Usage: snake_mcts_benchmark [--difficulty D] [--level L] [--seed S] [--threads N] [--ticks N]
+
+static void print_usage(const char *program) {
+    std::fprintf(stderr, "Usage: %s [--difficulty D] [--level L] [--seed S] [--threads N] [--ticks N]\n", program);
+}
+
+int main(int argc, char **argv) {
+    int32_t difficulty = Snake::DIFFICULTY_EASY;
+    uint32_t level = 1;
+    uint64_t seed = 1;
+    uint32_t max_ticks = 200;
+    Bots::MctsConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--difficulty") == 0) {
+            difficulty = std::strtol(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--level") == 0) {
+            level = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = std::strtoull(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            config.thread_count = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--ticks") == 0) {
+            max_ticks = std::strtoul(argv[++i], NULL, 10);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!Snake::is_valid_difficulty(difficulty) || level == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    Snake::Game game(0, 0, (Snake::GameDifficulty)difficulty, level, seed);
+    Bots::MctsPolicy policy(~seed, config);
+    while (game.get_game_result() == Snake::GAME_UNFINISHED && game.get_tick_count() < max_ticks) {
+        game.update_game(policy.next_input(&game));
+    }
+
+    const char *result = game.get_game_result() == Snake::GAME_LOST ? "lost" : "alive";
+    std::printf("difficulty %d level %u: %s after %u ticks, score %u\n", difficulty, level, result,
+                game.get_tick_count(), game.get_score());
+    std::printf("%llu playouts, %.0f playouts/s\n", (unsigned long long)policy.get_total_playouts(),
+                policy.get_playouts_per_second());
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "game/logic.hpp"
+#include "game/replay.hpp"
+#include "game/seekable_replay.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Builds seekable replays and jumps to any of their ticks.
+// Usage:
+//   snake_replay_seek index REPLAY.snkr OUTPUT.snks [KEYFRAME_INTERVAL]
+//   snake_replay_seek show SEEKABLE.snks TICK
+
+static int index_replay(const char *replay_path, const char *output_path, uint32_t keyframe_interval) {
+    Snake::Replay *replay = Snake::Replay::from_file(replay_path);
+    if (!replay) {
+        std::fprintf(stderr, "Could not read the replay %s\n", replay_path);
+        return 1;
+    }
+
+    Snake::SeekableReplay *seekable = Snake::SeekableReplay::from_replay(replay, keyframe_interval);
+    delete replay;
+    if (!seekable) {
+        std::fprintf(stderr, "The replay %s does not match its own simulation\n", replay_path);
+        return 1;
+    }
+
+    bool saved = seekable->save_as_file(output_path);
+    std::printf("%s: %u ticks, %zu keyframes, %zu bytes\n", output_path, seekable->get_tick_count(),
+                seekable->get_keyframe_count(), seekable->serialize().size());
+    delete seekable;
+    return saved ? 0 : 1;
+}
+
+static int show_tick(const char *seekable_path, uint32_t tick) {
+    Snake::SeekableReplay *seekable = Snake::SeekableReplay::from_file(seekable_path);
+    if (!seekable) {
+        std::fprintf(stderr, "Could not read the seekable replay %s\n", seekable_path);
+        return 1;
+    }
+
+    Snake::Game *game = seekable->create_game();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool found = seekable->seek(game, tick);
+    double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (found) {
+        Snake::Coordinates head = game->get_snake_body()->get_head();
+        Snake::Coordinates apple = game->get_apple_position();
+        std::printf("tick %u: score %u, head (%u, %u), apple (%u, %u), length %zu, result %d (seek took %.1f us)\n",
+                    game->get_tick_count(), game->get_score(), head.x, head.y, apple.x, apple.y,
+                    game->get_snake_body()->size(), game->get_game_result(), elapsed);
+    } else {
+        std::fprintf(stderr, "The replay only lasts %u ticks\n", seekable->get_tick_count());
+    }
+
+    delete game;
+    delete seekable;
+    return found ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && std::strcmp(argv[1], "index") == 0) {
+        uint32_t keyframe_interval = argc >= 5 ? std::strtoul(argv[4], NULL, 10) : DEFAULT_KEYFRAME_INTERVAL;
+        return index_replay(argv[2], argv[3], keyframe_interval);
+    }
+    if (argc == 4 && std::strcmp(argv[1], "show") == 0) {
+        return show_tick(argv[2], std::strtoul(argv[3], NULL, 10));
+    }
+
+    std::fprintf(stderr, "Usage:\n  %s index REPLAY OUTPUT [KEYFRAME_INTERVAL]\n  %s show SEEKABLE_REPLAY TICK\n", argv[0],
+                 argv[0]);
+    return 1;
+}
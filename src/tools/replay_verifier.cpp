@@ -0,0 +1,150 @@
+#include "game/logic.hpp"
+#include "game/random.hpp"
+#include "game/replay.hpp"
+#include "game/tick_schedule.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Re-simulates replay files headlessly and checks their claimed results.
+// Usage: snake_replay_verifier [--repeat N] FILE...
+//        snake_replay_verifier --self-test
+// Exits with 1 if any replay is invalid or unreadable, or if the self test fails
+
+static const char *result_name(Snake::GameResult result) {
+    switch (result) {
+        case Snake::GAME_WON:
+            return "won";
+        case Snake::GAME_LOST:
+            return "lost";
+        default:
+            return "unfinished";
+    }
+}
+
+// Records a game the way the local game loop does, on a simulated clock that stalls now and then,
+// and checks that its replay survives a save and a load and passes verify()
+static bool check_stalled_game(Snake::GameDifficulty difficulty, uint32_t level, uint64_t seed,
+                               uint64_t &dropped_ticks) {
+    const Snake::Direction square[4] = {Snake::DIRECTION_RIGHT, Snake::DIRECTION_DOWN, Snake::DIRECTION_LEFT,
+                                        Snake::DIRECTION_UP};
+    Snake::Game game(0, 0, difficulty, level, seed);
+    Snake::Replay *replay = Snake::Replay::for_game(&game);
+    Snake::RandomGenerator stalls(~seed);
+
+    int64_t now = 0;
+    Snake::TickSchedule schedule(&game, now);
+    while (!schedule.is_time_up(&game)) {
+        // the snake goes round a 6x6 square, which it always fits in
+        Snake::Direction input = square[game.get_tick_count() / 6 % 4];
+        replay->record_input(input);
+        if (game.update_game(input) != Snake::GAME_UNFINISHED) {
+            break;
+        }
+
+        // a stall of up to 3 seconds every 64 ticks or so, e.g. a suspended process
+        if (stalls.next_bounded(64) == 0) {
+            now += stalls.next_bounded(3'000'000) * 1000ll;
+        }
+        schedule.advance(now);
+        now = std::max(now, schedule.get_next_tick());
+    }
+    game.win_game();
+    replay->finish(&game);
+    dropped_ticks += schedule.get_dropped_ticks();
+
+    std::vector<uint8_t> buffer;
+    replay->serialize(buffer);
+    Snake::Replay *loaded = Snake::Replay::deserialize(buffer.data(), buffer.size());
+    bool valid = game.get_game_result() == Snake::GAME_WON && loaded && loaded->verify().valid;
+    if (!valid) {
+        std::printf("difficulty %d level %u seed %llu: FAILED (%s with %u points in %u ticks)\n", difficulty, level,
+                    (unsigned long long)seed, result_name(game.get_game_result()), game.get_score(),
+                    game.get_tick_count());
+    }
+
+    delete loaded;
+    delete replay;
+    return valid;
+}
+
+static int run_self_test() {
+    const Snake::GameDifficulty difficulties[] = {Snake::DIFFICULTY_EASY, Snake::DIFFICULTY_NORMAL,
+                                                  Snake::DIFFICULTY_HARD};
+    bool all_valid = true;
+    uint32_t game_count = 0;
+    uint64_t dropped_ticks = 0;
+    for (Snake::GameDifficulty difficulty : difficulties) {
+        for (uint32_t level = 1; level <= 8; level++) {
+            for (uint64_t seed = 0; seed < 4; seed++) {
+                all_valid = check_stalled_game(difficulty, level, seed, dropped_ticks) && all_valid;
+                game_count++;
+            }
+        }
+    }
+
+    // without dropped ticks the stalls were not long enough to test anything
+    all_valid = all_valid && dropped_ticks > 0;
+    std::printf("%u stalled games, %llu dropped ticks: %s\n", game_count, (unsigned long long)dropped_ticks,
+                all_valid ? "OK" : "FAILED");
+    return all_valid ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 2 && std::strcmp(argv[1], "--self-test") == 0) {
+        return run_self_test();
+    }
+
+    uint32_t repeat = 1;
+    int first_file = 1;
+    if (argc > 2 && std::strcmp(argv[1], "--repeat") == 0) {
+        repeat = std::max(1, std::atoi(argv[2]));
+        first_file = 3;
+    }
+
+    if (first_file >= argc) {
+        std::fprintf(stderr, "Usage: %s [--repeat N] FILE...\n       %s --self-test\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    bool all_valid = true;
+    uint64_t total_ticks = 0;
+    std::chrono::steady_clock::duration total_time(0);
+
+    for (int i = first_file; i < argc; i++) {
+        Snake::Replay *replay = Snake::Replay::from_file(argv[i]);
+        if (!replay) {
+            std::printf("%s: UNREADABLE\n", argv[i]);
+            all_valid = false;
+            continue;
+        }
+
+        Snake::ReplayVerification verification;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t r = 0; r < repeat; r++) {
+            verification = replay->verify();
+        }
+        total_time += std::chrono::steady_clock::now() - start;
+        total_ticks += (uint64_t)verification.simulated_ticks * repeat;
+
+        std::printf("%s: %s (claimed %s with %u points in %u ticks, simulated %s with %u points in %u ticks)\n",
+                    argv[i], verification.valid ? "OK" : "FAILED", result_name(replay->get_result()),
+                    replay->get_score(), replay->get_tick_count(), result_name(verification.simulated_result),
+                    verification.simulated_score, verification.simulated_ticks);
+
+        all_valid = all_valid && verification.valid;
+        delete replay;
+    }
+
+    double seconds = std::chrono::duration<double>(total_time).count();
+    if (seconds > 0) {
+        std::printf("Simulated %llu ticks in %.3f s (%.2f million ticks per second)\n", (unsigned long long)total_ticks,
+                    seconds, total_ticks / seconds / 1e6);
+    }
+
+    return all_valid ? 0 : 1;
+}
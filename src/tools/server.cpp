@@ -0,0 +1,98 @@
+#include "game/logic.hpp"
+#include "server/game_server.hpp"
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
+
+// Serves Snake to text terminals until SIGINT or SIGTERM, printing the number of sessions every few seconds.
+// Play with: stty raw -echo; nc 127.0.0.1 PORT; stty sane
+// Usage: snake_server [--tcp PORT] [--unix PATH] [--reactors N] [--difficulty D] [--level L] [--seed S]
+
+static void print_usage(const char *program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--tcp PORT] [--unix PATH] [--reactors N] [--difficulty D] [--level L] [--seed S]\n",
+                 program);
+}
+
+int main(int argc, char **argv) {
+    Server::ServerConfig config;
+    config.seed = time(NULL);
+    int32_t difficulty = Snake::DIFFICULTY_EASY;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--tcp") == 0) {
+            config.tcp_port = std::strtol(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--unix") == 0) {
+            config.unix_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--reactors") == 0) {
+            config.reactor_count = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--difficulty") == 0) {
+            difficulty = std::strtol(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--level") == 0) {
+            config.level = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            config.seed = std::strtoull(argv[++i], NULL, 10);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.tcp_port < 0 && !config.unix_path) {
+        config.tcp_port = 4242;
+    }
+    if (!Snake::is_valid_difficulty(difficulty) || config.level == 0 || config.level > SESSION_LAST_LEVEL ||
+        config.tcp_port > UINT16_MAX) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    config.difficulty = (Snake::GameDifficulty)difficulty;
+
+    // every session is a descriptor, thousands of them need more than the usual soft limit
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    // the reactors inherit the mask, so only the main thread receives the signals
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    try {
+        Server::GameServer server(config);
+        server.start();
+        if (config.tcp_port >= 0) {
+            std::printf("listening on %s:%u\n", config.tcp_address, server.get_tcp_port());
+        }
+        if (config.unix_path) {
+            std::printf("listening on %s\n", config.unix_path);
+        }
+        std::printf("%u reactors\n", server.get_reactor_count());
+        std::fflush(stdout);
+
+        struct timespec period = {5, 0};
+        while (sigtimedwait(&signals, NULL, &period) < 0) {
+            std::printf("%u sessions, %llu ticks\n", server.get_session_count(),
+                        (unsigned long long)server.get_tick_count());
+            std::fflush(stdout);
+        }
+        server.stop();
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
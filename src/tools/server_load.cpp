@@ -0,0 +1,145 @@
+#include "game/random.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+// Connects many players to a snake_server that type a key now and then, and reports how many sessions
+// stayed connected and how much the server sent them.
+// Usage: snake_server_load [--tcp PORT] [--unix PATH] [--sessions N] [--seconds S]
+
+static void print_usage(const char *program) {
+    std::fprintf(stderr, "Usage: %s [--tcp PORT] [--unix PATH] [--sessions N] [--seconds S]\n", program);
+}
+
+static int connect_to_server(int32_t tcp_port, const char *unix_path) {
+    int fd;
+    if (unix_path) {
+        struct sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, unix_path, sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(tcp_port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+int main(int argc, char **argv) {
+    int32_t tcp_port = 4242;
+    const char *unix_path = nullptr;
+    uint32_t session_count = 1000;
+    double duration = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--tcp") == 0) {
+            tcp_port = std::strtol(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--unix") == 0) {
+            unix_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--sessions") == 0) {
+            session_count = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--seconds") == 0) {
+            duration = std::strtod(argv[++i], NULL);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<int> fds;
+    for (uint32_t i = 0; i < session_count; i++) {
+        int fd = connect_to_server(tcp_port, unix_path);
+        if (fd < 0) {
+            std::fprintf(stderr, "connection %u failed: %s\n", i, std::strerror(errno));
+            break;
+        }
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u32 = fds.size();
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        fds.push_back(fd);
+    }
+    std::printf("%zu sessions connected\n", fds.size());
+
+    // every player types about one key per second: an arrow, or Enter to play again after a loss
+    const char *keys[] = {"\x1b[A", "\x1b[B", "\x1b[C", "\x1b[D", "w", "a", "s", "d", "\r"};
+    Snake::RandomGenerator random_generator(1);
+    std::vector<uint8_t> open(fds.size(), 1);
+    uint64_t received_bytes = 0;
+    uint64_t typed_keys = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point next_keys = start;
+    struct epoll_event events[256];
+    char buffer[1 << 16];
+    while (std::chrono::steady_clock::now() - start < std::chrono::duration<double>(duration)) {
+        if (std::chrono::steady_clock::now() >= next_keys) {
+            next_keys += std::chrono::milliseconds(100);
+            for (size_t i = 0; i < fds.size(); i++) {
+                if (open[i] && random_generator.next_bounded(10) == 0) {
+                    const char *key = keys[random_generator.next_bounded(9)];
+                    typed_keys += send(fds[i], key, std::strlen(key), MSG_NOSIGNAL | MSG_DONTWAIT) > 0;
+                }
+            }
+        }
+
+        int event_count = epoll_wait(epoll_fd, events, 256, 10);
+        for (int i = 0; i < event_count; i++) {
+            uint32_t index = events[i].data.u32;
+            ssize_t received = recv(fds[index], buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (received > 0) {
+                received_bytes += received;
+            } else if (received == 0 || (errno != EAGAIN && errno != EINTR)) {
+                open[index] = 0;
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fds[index], NULL);
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t open_count = 0;
+    for (size_t i = 0; i < fds.size(); i++) {
+        open_count += open[i];
+        close(fds[i]);
+    }
+    close(epoll_fd);
+
+    std::printf("%zu sessions still open after %.1f s, %llu keys typed\n", open_count, seconds,
+                (unsigned long long)typed_keys);
+    std::printf("received %.1f MB, %.1f KB/s per session\n", received_bytes / 1048576.0,
+                fds.empty() ? 0.0 : received_bytes / 1024.0 / seconds / fds.size());
+    return open_count == fds.size() ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "game/logic.hpp"
+#include "game/random.hpp"
+#include "runtime/timer_wheel.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Schedules the ticks of many games, each at the frame duration of a random difficulty and level,
+// with a timer wheel and with a binary heap over the same simulated time, and reports the cost of a tick for both.
+// Fails if the two do not run the same number of ticks.
+// Usage: snake_timer_benchmark [GAMES] [SECONDS]
+
+struct HeapTimer {
+    int64_t deadline;
+    uint64_t id;
+
+    bool operator>(const HeapTimer &other) const {
+        return deadline > other.deadline;
+    }
+};
+
+int main(int argc, char **argv) {
+    uint32_t game_count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 100000;
+    uint32_t simulated_seconds = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 60;
+    if (game_count == 0) {
+        std::fprintf(stderr, "Usage: %s [GAMES] [SECONDS]\n", argv[0]);
+        return 1;
+    }
+
+    // periods and first deadlines in nanoseconds
+    const Snake::GameDifficulty difficulties[] = {Snake::DIFFICULTY_EASY, Snake::DIFFICULTY_NORMAL,
+                                                  Snake::DIFFICULTY_HARD};
+    Snake::RandomGenerator random_generator(game_count);
+    std::vector<int64_t> periods(game_count);
+    std::vector<int64_t> first_deadlines(game_count);
+    for (uint32_t game = 0; game < game_count; game++) {
+        Snake::GameDifficulty difficulty = difficulties[random_generator.next_bounded(3)];
+        periods[game] = Snake::get_frame_duration(difficulty, 1 + random_generator.next_bounded(8)) * 1000ll;
+        first_deadlines[game] = random_generator.next_bounded(periods[game]);
+    }
+
+    // time advances one millisecond at a time, like a loop woken by a timer
+    const int64_t step = 1'000'000;
+    const int64_t end_time = (int64_t)simulated_seconds * 1'000'000'000;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Runtime::TimerWheel wheel(0, step);
+    for (uint32_t game = 0; game < game_count; game++) {
+        wheel.schedule(game, first_deadlines[game]);
+    }
+    std::vector<Runtime::TimerWheel::Timer> due;
+    uint64_t wheel_ticks = 0;
+    for (int64_t now = 0; now < end_time; now += step) {
+        due.clear();
+        wheel.advance(now, due);
+        for (const Runtime::TimerWheel::Timer &timer : due) {
+            wheel.schedule(timer.id, timer.deadline + periods[timer.id]);
+        }
+        wheel_ticks += due.size();
+    }
+    double wheel_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::priority_queue<HeapTimer, std::vector<HeapTimer>, std::greater<HeapTimer>> heap;
+    for (uint32_t game = 0; game < game_count; game++) {
+        heap.push({first_deadlines[game], game});
+    }
+    uint64_t heap_ticks = 0;
+    for (int64_t now = 0; now < end_time; now += step) {
+        while (!heap.empty() && heap.top().deadline <= now) {
+            HeapTimer timer = heap.top();
+            heap.pop();
+            heap.push({timer.deadline + periods[timer.id], timer.id});
+            heap_ticks++;
+        }
+    }
+    double heap_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%u games over %u s: %llu ticks\n", game_count, simulated_seconds, (unsigned long long)wheel_ticks);
+    std::printf("timer wheel: %6.1f ns/tick\n", wheel_seconds * 1e9 / wheel_ticks);
+    std::printf("binary heap: %6.1f ns/tick\n", heap_seconds * 1e9 / heap_ticks);
+    return wheel_ticks == heap_ticks ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include "bots/mcts.hpp"
+#include "bots/policy.hpp"
+#include "game/game.hpp"
+#include "game/level_list.hpp"
+#include "game/logic.hpp"
+#include "runtime/work_stealing_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Plays every (level, seed) game of a level list with a policy, spread over all the cores,
+// and writes score and survival statistics for every level.
+// The levels come from a file saved by the game (levels.bin), or are the default levels.
+// Usage: snake_tournament [--policy NAME] [--seeds N] [--threads N] [--levels FILE] [--output FILE]
+
+// Playouts of the tree search bot for every move of a tournament game
+#define TOURNAMENT_MCTS_PLAYOUTS 1000
+
+struct GameOutcome {
+    uint32_t score;
+    uint32_t ticks;
+    Snake::GameResult result;
+};
+
+struct TournamentLevel {
+    Snake::LevelInfo info;
+    std::vector<GameOutcome> outcomes; // one for every seed
+};
+
+static void print_usage(const char *program) {
+    std::fprintf(stderr, "Usage: %s [--policy NAME] [--seeds N] [--threads N] [--levels FILE] [--output FILE]\n",
+                 program);
+}
+
+// The games already run on every core: the tree search gets a single thread and a playout budget
+// instead of a share of the frame duration, so it does not play in real time
+static Bots::Policy *create_tournament_policy(const char *name, uint64_t seed) {
+    if (std::strcmp(name, "mcts") == 0) {
+        Bots::MctsConfig config;
+        config.thread_count = 1;
+        config.budget_fraction = 0;
+        config.max_playouts = TOURNAMENT_MCTS_PLAYOUTS;
+        return new Bots::MctsPolicy(seed, config);
+    }
+    return Bots::create_policy(name, seed);
+}
+
+int main(int argc, char **argv) {
+    const char *policy_name = "greedy";
+    uint32_t seed_count = 100;
+    uint32_t thread_count = 0;
+    const char *levels_path = nullptr;
+    const char *output_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (std::strcmp(argv[i], "--policy") == 0) {
+            policy_name = argv[++i];
+        } else if (std::strcmp(argv[i], "--seeds") == 0) {
+            seed_count = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            thread_count = std::strtoul(argv[++i], NULL, 10);
+        } else if (std::strcmp(argv[i], "--levels") == 0) {
+            levels_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0) {
+            output_path = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Bots::Policy *policy_check = create_tournament_policy(policy_name, 0);
+    if (!policy_check) {
+        std::fprintf(stderr, "Unknown policy %s\n", policy_name);
+        return 1;
+    }
+    delete policy_check;
+
+    Snake::LevelList *level_list =
+        levels_path ? Snake::LevelList::from_file(levels_path) : Snake::LevelList::default_levels();
+    if (!level_list || level_list->get_element_count() == 0) {
+        std::fprintf(stderr, "Could not read any level from %s\n", levels_path);
+        delete level_list;
+        return 1;
+    }
+    std::vector<TournamentLevel> levels(level_list->get_element_count());
+    for (size_t i = 0; i < levels.size(); i++) {
+        levels[i].info = level_list->get_element_at(i)->info;
+        levels[i].outcomes.resize(seed_count);
+    }
+    delete level_list;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Runtime::WorkStealingPool pool(thread_count);
+    for (TournamentLevel &level : levels) {
+        for (uint32_t seed_index = 0; seed_index < seed_count; seed_index++) {
+            pool.submit([&level, seed_index, policy_name]() {
+                uint64_t seed = ((uint64_t)level.info.difficulty << 56) ^ ((uint64_t)level.info.id << 32) ^ seed_index;
+                Snake::Game game(0, 0, level.info.difficulty, level.info.id, seed);
+                Bots::Policy *policy = create_tournament_policy(policy_name, ~seed);
+
+                Bots::play_game(&game, policy);
+                level.outcomes[seed_index] = {game.get_score(), game.get_tick_count(), game.get_game_result()};
+                delete policy;
+            });
+        }
+    }
+    pool.wait_idle();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    FILE *output = output_path ? std::fopen(output_path, "w") : stdout;
+    if (!output) {
+        std::fprintf(stderr, "Could not open %s\n", output_path);
+        return 1;
+    }
+
+    std::fprintf(output, "difficulty,level,frame_duration_us,games,wins,losses,mean_score,max_score,"
+                         "mean_ticks,mean_survival\n");
+    uint64_t total_ticks = 0;
+    for (const TournamentLevel &level : levels) {
+        uint32_t wins = 0, losses = 0, max_score = 0;
+        uint64_t score_sum = 0, tick_sum = 0;
+        for (const GameOutcome &outcome : level.outcomes) {
+            wins += outcome.result == Snake::GAME_WON;
+            losses += outcome.result == Snake::GAME_LOST;
+            max_score = std::max(max_score, outcome.score);
+            score_sum += outcome.score;
+            tick_sum += outcome.ticks;
+        }
+        total_ticks += tick_sum;
+
+        uint32_t duration_ticks = Snake::get_game_duration_ticks(level.info.difficulty, level.info.id);
+        double games = std::max<size_t>(1, level.outcomes.size());
+        std::fprintf(output, "%d,%u,%u,%zu,%u,%u,%.1f,%u,%.1f,%.3f\n", level.info.difficulty, level.info.id,
+                     Snake::get_frame_duration(level.info.difficulty, level.info.id), level.outcomes.size(), wins,
+                     losses, score_sum / games, max_score, tick_sum / games, tick_sum / games / duration_ticks);
+    }
+
+    if (output != stdout) {
+        std::fclose(output);
+    }
+    std::fprintf(stderr, "%zu games, %llu ticks in %.2f s on %u threads (%.2f M ticks/s, %llu tasks stolen)\n",
+                 levels.size() * seed_count, (unsigned long long)total_ticks, seconds, pool.get_thread_count(),
+                 total_ticks / seconds / 1e6, (unsigned long long)pool.get_stolen_task_count());
+    return 0;
+}